@@ -177,6 +177,12 @@ onEvent(PuglView* view, const PuglEvent* event)
   case PUGL_EXPOSE:
     onExpose(view);
     break;
+  case PUGL_PRESENT:
+    // Use when the frame was actually shown if the backend reports it
+    if (event->present.kind == PUGL_PRESENT_COMPLETE) {
+      app->lastFrameEndTime = fmax(app->lastFrameEndTime, event->present.time);
+    }
+    break;
   case PUGL_CLOSE:
     app->quit = 1;
     break;
@@ -462,10 +468,11 @@ updateTimeout(const PuglTestApp* const app)
      tend to pile up within a frame.
 
      To do this, we keep track of the time when the last frame was finished
-     drawing, and how long it took to expose (and assume this is relatively
-     stable).  Then, we can calculate how much time there is from now until the
-     time when we should start drawing to not miss the deadline, and use that
-     as the timeout for puglUpdate().
+     drawing (or was shown, if the backend sends present events), and how long
+     it took to expose (and assume this is relatively stable).  Then, we can
+     calculate how much time there is from now until the time when we should
+     start drawing to not miss the deadline, and use that as the timeout for
+     puglUpdate().
   */
 
   const int    refreshRate      = puglGetViewHint(app->view, PUGL_REFRESH_RATE);
@@ -1,4 +1,4 @@
-// Copyright 2012-2025 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 /*
@@ -172,7 +172,7 @@ main(int argc, char** argv)
   app.continuous = opts.continuous;
   app.verbose    = opts.verbose;
 
-  app.world         = puglNewWorld(PUGL_PROGRAM, 0);
+  app.world         = puglNewWorld(PUGL_PROGRAM, PUGL_WORLD_GROUP_SWAPS);
   app.cubes[0].view = puglNewView(app.world);
   app.cubes[1].view = puglNewView(app.world);
 
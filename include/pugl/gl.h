@@ -1,4 +1,4 @@
-// Copyright 2012-2023 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #ifndef PUGL_GL_H
@@ -62,6 +62,75 @@ puglEnterContext(PuglView* view);
 PUGL_API PuglStatus
 puglLeaveContext(PuglView* view);
 
+/**
+   Return the age of the back buffer that is being drawn to.
+
+   This can be called while handling a #PuglExposeEvent to find out which
+   earlier frame the back buffer still contains.  An age of 1 means it
+   contains the last frame, 2 means the one before that, and so on.  An
+   application that keeps a short history of damage can use this to redraw
+   only the regions that have changed since then.
+
+   If the #PUGL_PRESERVE_CONTENTS hint is set and supported, then exposed
+   regions are copied from the back buffer to the window instead of swapping
+   buffers, so the age is always 1 unless the view has been resized.
+
+   X11: Supported with GLX_EXT_buffer_age, and #PUGL_PRESERVE_CONTENTS is
+   supported with GLX_MESA_copy_sub_buffer.
+
+   Other platforms: Not supported.
+
+   @return The age of the back buffer in frames, or 0 if its contents are
+   unknown or this isn't called while drawing, so the whole view must be
+   drawn.
+*/
+PUGL_API unsigned
+puglGetBufferAge(const PuglView* view);
+
+/**
+   Swap the buffers of the OpenGL context to show what has been drawn.
+
+   This is only needed when the #PUGL_RENDER_THREAD hint is set, to show a
+   frame that was drawn on the render thread.  Otherwise, buffers are swapped
+   automatically after each expose.  It must be called while the context is
+   entered with puglEnterContext(), and may block until the display refreshes
+   depending on the swap interval.
+
+   With #PUGL_RENDER_THREAD, the context isn't entered for any events,
+   including #PUGL_REALIZE and #PUGL_UNREALIZE, so resources must be created
+   and destroyed on the render thread.  The render thread must leave the
+   context and stop drawing before the view is unrealized or freed.
+
+   @return #PUGL_FAILURE if the view isn't realized.
+*/
+PUGL_API PuglStatus
+puglSwapBuffers(PuglView* view);
+
+/**
+   Set the view to share OpenGL resources with.
+
+   If set, the context of `view` will be created in the same share group as
+   the context of `other`, so objects like textures, buffers, and shader
+   programs that are created in one are available in both.  This can save a
+   lot of memory and setup time when many views draw the same resources.
+
+   This must be called before `view` is realized, and `other` must be a
+   realized view with the OpenGL backend in the same world.  Views can be
+   chained, so several views can share with one that shares with another,
+   and they are all in the same group.  Objects remain available as long as
+   any view in the group is realized, but note that container objects like
+   vertex arrays and framebuffers are never shared.
+
+   @param view The view to set the shared context of.
+   @param other The view to share resources with, or null to not share.
+   @return #PUGL_FAILURE if `view` is already realized, or
+   #PUGL_BAD_PARAMETER if `other` is `view` or in a different world.
+   Realizing `view` fails with #PUGL_BAD_CONFIGURATION if `other` isn't a
+   realized OpenGL view on the same screen.
+*/
+PUGL_API PuglStatus
+puglSetSharedContext(PuglView* view, PuglView* other);
+
 /**
    OpenGL graphics backend.
 
@@ -0,0 +1,73 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef PUGL_PIXELS_H
+#define PUGL_PIXELS_H
+
+#include <pugl/attributes.h>
+#include <pugl/pugl.h>
+
+#include <stddef.h>
+
+PUGL_BEGIN_DECLS
+
+/**
+   @defgroup pugl_pixels Pixels
+   Raw pixel buffer support.
+
+   This backend provides a buffer of pixels in memory for the application to
+   draw to however it likes, for example with a custom software renderer.
+   After each expose, the exposed region of the buffer is copied to the window
+   without involving any graphics API.  On X11, the buffer is shared with the
+   server using the MIT-SHM extension if possible, so pixels aren't sent
+   through the socket at all.
+
+   @ingroup pugl_backend
+   @{
+*/
+
+/// Format of pixels in a #PuglPixels buffer
+typedef enum {
+  /**
+     32-bit native-endian pixels with 8 bits per channel.
+
+     Each pixel is a `uint32_t` with red, green, and blue in the lowest 24 bits
+     like 0xXXRRGGBB.  The highest 8 bits are ignored.
+  */
+  PUGL_PIXEL_FORMAT_XRGB32,
+} PuglPixelFormat;
+
+/**
+   A buffer of pixels to draw to.
+
+   A pointer to this is returned by puglGetContext() while handling a
+   #PuglExposeEvent.  Only the exposed region (see puglGetExposeRects()) is
+   copied to the window after the expose, and, as with other backends,
+   everything else is undefined unless #PUGL_PRESERVE_CONTENTS is set.
+*/
+typedef struct {
+  void*           data;   ///< Pointer to the top-left pixel
+  size_t          stride; ///< Number of bytes between the start of rows
+  PuglSpan        width;  ///< Width in pixels
+  PuglSpan        height; ///< Height in pixels
+  PuglPixelFormat format; ///< Pixel format
+} PuglPixels;
+
+/**
+   Pixels graphics backend accessor.
+
+   Pass the returned value to puglSetBackend() to draw to a view by writing
+   pixels directly.  The #PUGL_SURFACE_TYPE hint can be set to
+   #PUGL_IMAGE_SURFACE to avoid using shared memory, and after the view is
+   realized, it's set to the type of surface that is actually used.
+*/
+PUGL_CONST_API const PuglBackend*
+puglPixelsBackend(void);
+
+/**
+   @}
+*/
+
+PUGL_END_DECLS
+
+#endif // PUGL_PIXELS_H
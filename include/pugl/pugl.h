@@ -59,6 +59,14 @@ typedef struct {
   PuglSpan height;
 } PuglArea;
 
+/// A 2-dimensional rectangle within/of a view
+typedef struct {
+  PuglCoord x;
+  PuglCoord y;
+  PuglSpan  width;
+  PuglSpan  height;
+} PuglRect;
+
 /**
    @}
    @defgroup pugl_events Events
@@ -91,6 +99,7 @@ typedef enum {
   PUGL_LOOP_LEAVE,     ///< Recursive loop left, a #PuglLoopLeaveEvent
   PUGL_DATA_OFFER,     ///< Data offered from clipboard, a #PuglDataOfferEvent
   PUGL_DATA,           ///< Data available from clipboard, a #PuglDataEvent
+  PUGL_PRESENT,        ///< Frame presented, a #PuglPresentEvent
 } PuglEventType;
 
 /// Common flags for all event types
@@ -558,8 +567,9 @@ typedef struct {
 /**
    Custom client message event.
 
-   This is a custom event sent to a view with puglSendEvent(), which wakes up
-   the event loop and delivers two pointer-sized data fields.  These
+   This is a custom event sent to a view with puglSendEvent() or
+   puglPostClientEvent(), which wakes up the event loop and delivers two
+   pointer-sized data fields.  These
    client-specific fields are opaque to Pugl and aren't interpreted in any way.
 */
 typedef struct {
@@ -648,6 +658,44 @@ typedef struct {
   uint32_t       typeIndex; ///< Index of datatype
 } PuglDataEvent;
 
+/**
+   @}
+   @defgroup pugl_present_events Presentation Events
+   @{
+*/
+
+/// The kind of notification in a #PuglPresentEvent
+typedef enum {
+  PUGL_PRESENT_COMPLETE, ///< Frame was shown on the display
+  PUGL_PRESENT_IDLE,     ///< Buffer used for a frame is no longer in use
+} PuglPresentKind;
+
+/**
+   Frame presentation event.
+
+   This is sent after a view has been exposed, when the drawn frame is
+   actually shown on the display, and when the buffer it was drawn to is free
+   to be drawn to again.  Applications can use completion events to pace
+   drawing to the display refresh, for example by obscuring the view to draw
+   the next frame when the last one was shown.
+
+   These are only sent when frames are presented at the display refresh
+   (see #PUGL_SWAP_INTERVAL), which isn't supported by all backends and
+   platforms.  With OpenGL on X11, completion events are sent for swapped
+   frames if GLX_OML_sync_control is supported.  With Vulkan, they're instead
+   sent if timing is enabled for a swapchain managed by Pugl (see
+   puglSetVulkanSwapchain()).
+*/
+typedef struct {
+  PuglEventType   type;   ///< #PUGL_PRESENT
+  PuglEventFlags  flags;  ///< Bitwise OR of #PuglEventFlag values
+  PuglPresentKind kind;   ///< Kind of notification
+  uint32_t        serial; ///< Serial number of the frame, counting from 1
+  uint64_t        msc;    ///< Refresh count when shown, or zero if unknown
+  double          time;   ///< Time in seconds when shown, for completion only
+  uint32_t        missed; ///< Refreshes the frame was shown late by, if known
+} PuglPresentEvent;
+
 /**
    @}
 */
@@ -679,6 +727,7 @@ typedef union {
   PuglTimerEvent     timer;     ///< #PUGL_TIMER
   PuglDataOfferEvent offer;     ///< #PUGL_DATA_OFFER
   PuglDataEvent      data;      ///< #PUGL_DATA
+  PuglPresentEvent   present;   ///< #PUGL_PRESENT
 } PuglEvent;
 
 /**
@@ -783,6 +832,22 @@ typedef enum {
      X11: Calls XInitThreads() which is required for some drivers.
   */
   PUGL_WORLD_THREADS = 1U << 0U,
+
+  /**
+     Swap the buffers of all OpenGL views together.
+
+     By default, the buffers of a view are swapped as soon as it's drawn, so
+     with a swap interval of 1, several views that are drawn in one update may
+     each wait for a vertical blank in turn.  With this flag, all views are
+     drawn first, then their buffers are swapped together, and only the last
+     swap waits for the vertical blank.
+
+     X11: Buffers of all but the last view are swapped with an interval of
+     zero, which may cause tearing without a compositor.
+
+     Other platforms: Ignored.
+  */
+  PUGL_WORLD_GROUP_SWAPS = 1U << 1U,
 } PuglWorldFlag;
 
 /// Bitwise OR of #PuglWorldFlag values
@@ -885,6 +950,168 @@ puglGetTime(const PuglWorld* world);
 PUGL_API PuglStatus
 puglUpdate(PuglWorld* world, double timeout);
 
+/// Conditions to watch for on a file descriptor
+typedef enum {
+  PUGL_WATCH_READ  = 1U << 0U, ///< File descriptor is readable
+  PUGL_WATCH_WRITE = 1U << 1U, ///< File descriptor is writable
+} PuglWatchFlag;
+
+/// Bitwise OR of #PuglWatchFlag values
+typedef uint32_t PuglWatchFlags;
+
+/**
+   A function called when a watched file descriptor is ready.
+
+   @param world The world that the file descriptor is watched by.
+   @param fd The file descriptor that is ready.
+   @param flags The conditions that are ready, a subset of the watched ones.
+   @param data The user data passed to puglWatchFd().
+   @return An error status which will be returned from puglUpdate(), or
+   #PUGL_SUCCESS.
+*/
+typedef PuglStatus (*PuglWatchFunc)(PuglWorld*     world,
+                                    int            fd,
+                                    PuglWatchFlags flags,
+                                    void*          data);
+
+/**
+   Watch a file descriptor in the event loop.
+
+   This adds a file descriptor, like a socket or pipe, to the set that
+   puglUpdate() waits on along with the window system connection.  When it
+   becomes ready for any of the given conditions, `func` is called during
+   puglUpdate(), so a single thread can handle both the user interface and
+   other I/O without polling.
+
+   If the file descriptor is already watched, the watch is replaced.  The
+   callback may add or remove watches, including its own.
+
+   Currently only supported on X11.
+
+   @param world The world to watch the file descriptor in.
+   @param fd The file descriptor to watch.
+   @param flags The conditions to watch for.
+   @param func The function to call when the file descriptor is ready.
+   @param data User data to pass to `func`.
+
+   @return #PUGL_UNSUPPORTED if watching file descriptors isn't supported,
+   #PUGL_BAD_PARAMETER if the arguments are invalid, #PUGL_NO_MEMORY if adding
+   the watch failed, or #PUGL_SUCCESS.
+*/
+PUGL_API PuglStatus
+puglWatchFd(PuglWorld*     world,
+            int            fd,
+            PuglWatchFlags flags,
+            PuglWatchFunc  func,
+            void*          data);
+
+/**
+   Stop watching a file descriptor.
+
+   @param world The world the file descriptor is watched in.
+   @param fd The file descriptor previously passed to puglWatchFd().
+
+   @return #PUGL_UNSUPPORTED if watching file descriptors isn't supported,
+   #PUGL_FAILURE if the file descriptor isn't watched, or #PUGL_SUCCESS.
+*/
+PUGL_API PuglStatus
+puglUnwatchFd(PuglWorld* world, int fd);
+
+/**
+   Return a file descriptor that becomes readable when the world has events.
+
+   This, along with puglPrepareUpdate(), puglCheckUpdate(), and
+   puglDispatchUpdate(), allows a world to be driven by a foreign event loop
+   (like those of GLib or libuv) which waits on it along with other sources,
+   instead of by puglUpdate().  An iteration of such a loop looks like:
+
+   1. Call puglPrepareUpdate() to get the maximum time to wait.
+   2. Wait until this file descriptor is readable, or the timeout elapses.
+   3. Call puglCheckUpdate(), and if it returns true, puglDispatchUpdate().
+
+   Note that file descriptors watched with puglWatchFd() aren't waited on in
+   this case, so the host loop should watch those as well.  Similarly, events
+   posted with puglPostClientEvent() don't make this file descriptor readable,
+   so the loop should also wait on the one returned by puglGetWakeFd().
+
+   Currently only supported on X11, where this is the connection to the server.
+
+   @return A file descriptor, or -1 if this isn't supported.
+*/
+PUGL_API int
+puglGetWorldFd(const PuglWorld* world);
+
+/**
+   Return a file descriptor that becomes readable when events are posted.
+
+   This becomes readable when puglPostClientEvent() is called, so a foreign
+   event loop that waits on puglGetWorldFd() can wait on this as well to be
+   woken up by other threads.  It's reset when the world is dispatched, and
+   must not be read from or closed by the application.
+
+   Currently only supported on X11.
+
+   @return A file descriptor, or -1 if this isn't supported.
+*/
+PUGL_API int
+puglGetWakeFd(const PuglWorld* world);
+
+/**
+   Return the time when the world next needs to be dispatched.
+
+   This is the earliest time, in the same clock as puglGetTime(), that there is
+   work to do, such as the next timer expiring.  If there is already work to
+   do, like events to dispatch or views to redraw, then this returns a time
+   that isn't in the future.
+
+   @return A time in seconds, or a negative value if the world can wait for
+   events indefinitely.
+*/
+PUGL_API double
+puglGetNextDeadline(const PuglWorld* world);
+
+/**
+   Prepare to wait for events in a foreign event loop.
+
+   This flushes any pending output to the window system, and must be called
+   before waiting for the world's file descriptor to become readable.
+
+   @param world The world to prepare.
+
+   @param[out] timeout Set to the maximum time, in seconds, that the caller may
+   wait before calling puglCheckUpdate().  Zero if there's already work to do,
+   or negative if the caller may wait indefinitely.
+
+   @return #PUGL_UNSUPPORTED if foreign event loops aren't supported, or
+   #PUGL_SUCCESS.
+*/
+PUGL_API PuglStatus
+puglPrepareUpdate(PuglWorld* world, double* timeout);
+
+/**
+   Check if the world has work to do after waiting.
+
+   This reads any events that are available from the window system, without
+   blocking, and checks for expired timers and pending redisplays.
+
+   @return True if puglDispatchUpdate() should be called.  Always true if
+   foreign event loops aren't supported.
+*/
+PUGL_API bool
+puglCheckUpdate(PuglWorld* world);
+
+/**
+   Dispatch all pending work without waiting.
+
+   This processes events, timers, and redisplays in the same way as
+   puglUpdate() with a timeout of zero.
+
+   @return #PUGL_SUCCESS if events are read, #PUGL_FAILURE if no events are
+   read, or an error.
+*/
+PUGL_API PuglStatus
+puglDispatchUpdate(PuglWorld* world);
+
 /**
    @}
    @defgroup pugl_backend Backend
@@ -955,10 +1182,15 @@ typedef enum {
   PUGL_VIEW_TYPE,             ///< View type (a #PuglViewType)
   PUGL_DARK_FRAME,            ///< True if window frame should be dark
   PUGL_ACCEPT_DROP,           ///< True if view accepts dropped data
+  PUGL_COALESCE_CONFIGURE,    ///< True if configures are merged per update
+  PUGL_COALESCE_POINTER,      ///< True if motion/scroll is merged per update
+  PUGL_PRESERVE_CONTENTS,     ///< True if drawing is kept between exposes
+  PUGL_SURFACE_TYPE,          ///< Type of drawing surface (server/image)
+  PUGL_RENDER_THREAD,         ///< True if drawing is done on another thread
 } PuglViewHint;
 
 /// The number of #PuglViewHint values
-#define PUGL_NUM_VIEW_HINTS 21U
+#define PUGL_NUM_VIEW_HINTS 26U
 
 /// A special view hint value
 typedef enum {
@@ -969,6 +1201,9 @@ typedef enum {
   PUGL_OPENGL_ES_API                = 3,  ///< For #PUGL_CONTEXT_API
   PUGL_OPENGL_CORE_PROFILE          = 4,  ///< For #PUGL_CONTEXT_PROFILE
   PUGL_OPENGL_COMPATIBILITY_PROFILE = 5,  ///< For #PUGL_CONTEXT_PROFILE
+  PUGL_SERVER_SURFACE               = 6,  ///< For #PUGL_SURFACE_TYPE
+  PUGL_IMAGE_SURFACE                = 7,  ///< For #PUGL_SURFACE_TYPE
+  PUGL_SHARED_IMAGE_SURFACE         = 8,  ///< For #PUGL_SURFACE_TYPE
 } PuglViewHintValue;
 
 /// View type
@@ -1479,6 +1714,38 @@ puglObscureRegion(PuglView* view,
                   unsigned  width,
                   unsigned  height);
 
+/**
+   Scroll the contents of a region and obscure only the revealed area.
+
+   This moves what has already been drawn within a rectangle by `dx` and `dy`,
+   discarding anything moved outside of it, then obscures the strips that are
+   revealed by the move.  The following expose only covers those strips, so
+   scrolling a large view costs about as much as drawing the newly visible
+   content.  Like puglObscureRegion(), this should be called while handling a
+   #PuglUpdateEvent, or outside of event handling.
+
+   On X11, this is supported by the stub, Cairo, and pixels backends, and by
+   the OpenGL backend if #PUGL_PRESERVE_CONTENTS is true.  Where contents
+   can't be moved, the whole region is obscured instead, so the application
+   doesn't need to handle that case specially.
+
+   @param view The view to scroll.
+   @param x The top-left X coordinate of the rectangle to scroll.
+   @param y The top-left Y coordinate of the rectangle to scroll.
+   @param width The width of the rectangle to scroll.
+   @param height The height of the rectangle to scroll.
+   @param dx The distance to move contents right, or left if negative.
+   @param dy The distance to move contents down, or up if negative.
+*/
+PUGL_API PuglStatus
+puglScrollRegion(PuglView* view,
+                 int       x,
+                 int       y,
+                 unsigned  width,
+                 unsigned  height,
+                 int       dx,
+                 int       dy);
+
 /**
    @}
    @defgroup pugl_interaction Interaction
@@ -1696,10 +1963,13 @@ puglSetCursor(PuglView* view, PuglCursor cursor);
    only a few timers, and perform several tasks in each if necessary.
 
    @param timeout The period, in seconds, of this timer.  The maximum supported
-   resolution is about 10 ms on Windows, and about 1 ms on X11 and MacOS.
+   resolution is about 10 ms on Windows, and about 1 ms on MacOS.  On X11,
+   timers are handled by the event loop without any server requests, so the
+   resolution is only limited by how promptly puglUpdate() is called.
 
    @return #PUGL_FAILURE if timers aren't supported by the system,
-   #PUGL_UNKNOWN_ERROR if setting the timer failed.
+   #PUGL_NO_MEMORY if allocating the timer failed, #PUGL_UNKNOWN_ERROR if
+   setting the timer failed.
 */
 PUGL_API PuglStatus
 puglStartTimer(PuglView* view, uintptr_t id, double timeout);
@@ -1716,6 +1986,47 @@ puglStartTimer(PuglView* view, uintptr_t id, double timeout);
 PUGL_API PuglStatus
 puglStopTimer(PuglView* view, uintptr_t id);
 
+/**
+   Return the motion events that were merged into the current one.
+
+   If #PUGL_COALESCE_POINTER is true, consecutive motion events are merged
+   into a single #PUGL_MOTION event with the latest position (and consecutive
+   scroll events in the same direction are merged into a single #PUGL_SCROLL
+   event with the total distance).  While handling a merged motion event, this
+   returns every merged event, oldest first and including the latest one, for
+   applications that need every sample, like drawing tools.  The history
+   always contains at least the event being handled, so a motion event that
+   wasn't merged with any others has a history of one.
+
+   @param view The view to get the motion history for.
+   @param[out] count Set to the number of events in the returned array.
+   @return An array of motion events which is only valid while handling a
+   #PUGL_MOTION event, or null with `count` set to zero if pointer events
+   aren't being coalesced, or if no motion event is being handled.
+*/
+PUGL_API const PuglMotionEvent*
+puglGetMotionHistory(const PuglView* view, size_t* count);
+
+/**
+   Return the rectangles that make up the region of the current expose.
+
+   The region of a #PUGL_EXPOSE event is the bounding box of everything that
+   needs to be redrawn, which may be much larger, for example if small areas in
+   opposite corners of the view were obscured.  While handling an expose event,
+   this returns a few rectangles whose union covers everything that needs to be
+   redrawn, so applications can avoid drawing anything else.  Backends clip
+   drawing to this region where possible.
+
+   Currently only supported on X11.
+
+   @param view The view being exposed.
+   @param[out] count Set to the number of rectangles in the returned array.
+   @return An array of rectangles which is only valid while handling a
+   #PUGL_EXPOSE event, or null if the whole expose region should be drawn.
+*/
+PUGL_API const PuglRect*
+puglGetExposeRects(const PuglView* view, size_t* count);
+
 /**
    Send an event to a view via the window system.
 
@@ -1734,6 +2045,28 @@ puglStopTimer(PuglView* view, uintptr_t id);
 PUGL_API PuglStatus
 puglSendEvent(PuglView* view, const PuglEvent* event);
 
+/**
+   Post a #PUGL_CLIENT event to a view from any thread.
+
+   This is a cheap way for other threads, like audio or worker threads, to
+   send messages to a view and wake up the event loop.  It's safe to call from
+   several threads at once, without #PUGL_WORLD_THREADS.
+
+   X11: Events are added to a lock-free queue in the world, which is drained
+   during puglUpdate().  This doesn't involve the X server or Xlib's lock, and
+   events from one thread are received in the order they were posted.
+
+   Other platforms: Events are posted to the system event queue.
+
+   Events that haven't been dispatched when the view is freed are discarded,
+   but the caller must ensure that the view isn't freed while this is being
+   called.
+
+   @return #PUGL_FAILURE if the queue is full, or #PUGL_SUCCESS.
+*/
+PUGL_API PuglStatus
+puglPostClientEvent(PuglView* view, uintptr_t data1, uintptr_t data2);
+
 /**
    @}
    @}
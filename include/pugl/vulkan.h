@@ -1,4 +1,4 @@
-// Copyright 2012-2023 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 /*
@@ -15,6 +15,7 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 PUGL_BEGIN_DECLS
@@ -59,7 +60,8 @@ typedef struct PuglVulkanLoaderImpl PuglVulkanLoader;
    This dynamically loads the Vulkan library and gets the load functions from
    it.
 
-   @param world The world the returned loader is a part of.
+   @param world The world the returned loader is a part of, or null to use
+   Vulkan without a window system, like with puglCreateHeadlessSurface().
 
    @param libraryName The name of the Vulkan library to load, or null.
    Typically, this is left unset, which will load the standard Vulkan library
@@ -129,6 +131,196 @@ puglCreateSurface(PFN_vkGetInstanceProcAddr    vkGetInstanceProcAddr,
                   const VkAllocationCallbacks* allocator,
                   VkSurfaceKHR*                surface);
 
+/**
+   Return the Vulkan instance extensions required for a headless surface.
+
+   This simply returns static strings, it does not access Vulkan or the window
+   system.  The returned array contains "VK_KHR_surface" and
+   "VK_EXT_headless_surface".
+
+   @param[out] count The number of extensions in the returned array.
+   @return An array of extension name strings.
+*/
+PUGL_API const char* const*
+puglGetHeadlessInstanceExtensions(uint32_t* count);
+
+/**
+   Create a headless Vulkan surface that isn't shown anywhere.
+
+   This uses the `VK_EXT_headless_surface` extension to create a surface
+   without a view or window system, so it can be used without a display, for
+   example to render offscreen in tests or benchmarks on machines without a
+   GPU or display server.  The surface behaves like any other, except that
+   presented images are simply discarded.  Its extent is undefined, so the
+   size of swapchain images must be chosen by the application.
+
+   @param vkGetInstanceProcAddr Accessor for Vulkan functions.
+   @param instance The Vulkan instance, which must have been created with the
+   extensions returned by puglGetHeadlessInstanceExtensions().
+   @param allocator Vulkan allocation callbacks, may be NULL.
+   @param[out] surface Pointed to a newly created Vulkan surface.
+   @return `VK_SUCCESS` on success, `VK_ERROR_EXTENSION_NOT_PRESENT` if the
+   extension isn't available, or another Vulkan error code.
+*/
+PUGL_API VkResult
+puglCreateHeadlessSurface(PFN_vkGetInstanceProcAddr    vkGetInstanceProcAddr,
+                          VkInstance                   instance,
+                          const VkAllocationCallbacks* allocator,
+                          VkSurfaceKHR*                surface);
+
+/// The maximum number of frames in flight for a managed swapchain
+#define PUGL_VULKAN_MAX_FRAMES 4U
+
+/// Flags for a swapchain that is managed by Pugl
+typedef enum {
+  /**
+     Report when frames are shown with `VK_KHR_present_wait`.
+
+     If this is set, then the device must have been created with the
+     `VK_KHR_present_id` and `VK_KHR_present_wait` extensions and features
+     enabled.  Pugl then sends a #PUGL_PRESENT event when each frame is shown,
+     with the time it was noticed, since this extension provides no
+     timestamps.
+  */
+  PUGL_VULKAN_PRESENT_WAIT = 1U << 0U,
+
+  /**
+     Report when frames are shown with `VK_GOOGLE_display_timing`.
+
+     If this is set, then the device must have been created with the
+     `VK_GOOGLE_display_timing` extension enabled.  Pugl then sends a
+     #PUGL_PRESENT event with the actual time that each frame was shown.  This
+     is only used if #PUGL_VULKAN_PRESENT_WAIT isn't set or isn't supported.
+  */
+  PUGL_VULKAN_DISPLAY_TIMING = 1U << 1U,
+} PuglVulkanSwapchainFlag;
+
+/// Bitwise OR of #PuglVulkanSwapchainFlag values
+typedef uint32_t PuglVulkanSwapchainFlags;
+
+/**
+   Options for a swapchain that is managed by Pugl.
+
+   The application creates the device and surface as usual, and passes them
+   to puglSetVulkanSwapchain() to have Pugl create and maintain a swapchain
+   for the view.
+*/
+typedef struct {
+  VkPhysicalDevice             physicalDevice; ///< Device for the surface
+  VkDevice                     device;         ///< Device to create objects on
+  VkQueue                      presentQueue;   ///< Queue to present on
+  VkSurfaceKHR                 surface;        ///< Surface for the view
+  const VkAllocationCallbacks* allocator;      ///< Vulkan allocator, or null
+
+  /**
+     Preferred image format.
+
+     If this is `VK_FORMAT_UNDEFINED` or isn't supported, then the first
+     format that the surface supports is used.
+  */
+  VkFormat format;
+
+  /**
+     Additional image usage flags.
+
+     Swapchain images can always be used as color attachments, so this only
+     needs to be set for other uses, for example, to
+     `VK_IMAGE_USAGE_TRANSFER_DST_BIT` to clear or copy to images directly.
+  */
+  VkImageUsageFlags usage;
+
+  /**
+     Preferred present mode.
+
+     If this isn't supported, then `VK_PRESENT_MODE_FIFO_KHR` is used, which
+     is always supported.
+  */
+  VkPresentModeKHR presentMode;
+
+  /**
+     Number of frames that can be drawn before waiting for the GPU.
+
+     This is clamped to between 1 and #PUGL_VULKAN_MAX_FRAMES.
+  */
+  uint32_t numFrames;
+
+  /// Bitwise OR of #PuglVulkanSwapchainFlag values
+  PuglVulkanSwapchainFlags flags;
+} PuglVulkanSwapchainOptions;
+
+/**
+   A frame to draw to a view with a managed swapchain.
+
+   While handling a #PuglExposeEvent, puglGetContext() returns a pointer to
+   this with an image that has been acquired from the swapchain.  Drawing
+   must wait for `acquired`, and the last submission must signal both
+   `rendered` and `fence`, since Pugl waits for them to present the image
+   after the expose, and to reuse the frame later.
+*/
+typedef struct {
+  VkImage          image;       ///< Swapchain image to draw to
+  VkImageView      imageView;   ///< Color view of the whole image
+  VkFormat         format;      ///< Format of the image
+  VkExtent2D       extent;      ///< Size of the image
+  VkPresentModeKHR presentMode; ///< Present mode of the swapchain
+  uint32_t         numImages;   ///< Number of images in the swapchain
+  uint32_t         imageIndex;  ///< Index of the image in the swapchain
+  uint32_t         frameIndex;  ///< Index of the frame in flight
+  uint32_t         serial;      ///< Serial number of the frame, from 1
+  VkSemaphore      acquired;    ///< Signaled when the image can be drawn
+  VkSemaphore      rendered;    ///< Must be signaled when drawing is done
+  VkFence          fence;       ///< Must be signaled by the last submission
+
+  /**
+     True if the swapchain was created since the last frame.
+
+     Anything that depends on the swapchain images, like framebuffers or
+     command buffers, must be recreated when this is set.
+  */
+  bool recreated;
+} PuglVulkanFrame;
+
+/**
+   Have Pugl manage the swapchain of a view.
+
+   This creates a swapchain for the view's surface, along with the
+   semaphores and fences for each frame in flight.  Then, before each
+   expose, Pugl waits until the next frame is free, recreates the swapchain
+   if the view has been resized, and acquires an image.  The application
+   gets this as a #PuglVulkanFrame from puglGetContext() during the expose,
+   and the image is presented after it.  If there's no image to draw to, for
+   example because the window is minimized, then puglGetContext() returns
+   null.
+
+   If timing is enabled by the flags in the options, then a #PUGL_PRESENT
+   event is sent to the view when each frame is shown, with the same serial
+   as the #PuglVulkanFrame it was drawn to.  Frames presented to a swapchain
+   that has since been recreated aren't reported.  Since Vulkan provides no
+   way to wait for these, the event loop polls for them while any are
+   outstanding.
+
+   This must be called after the view is realized.  It can be called again
+   to change the options, or with null options to destroy the swapchain,
+   which must be done before the device or surface is destroyed.
+
+   X11: Supported.
+
+   Other platforms: Not supported.
+
+   @param view The view to manage the swapchain of.
+   @param vkGetInstanceProcAddr Accessor for Vulkan functions.
+   @param instance The Vulkan instance.
+   @param options Swapchain options, or null to destroy the swapchain.
+   @return #PUGL_FAILURE if the view isn't realized, #PUGL_UNSUPPORTED if
+   the required functions aren't available, or #PUGL_CREATE_CONTEXT_FAILED
+   if creating Vulkan objects fails.
+*/
+PUGL_API PuglStatus
+puglSetVulkanSwapchain(PuglView*                         view,
+                       PFN_vkGetInstanceProcAddr         vkGetInstanceProcAddr,
+                       VkInstance                        instance,
+                       const PuglVulkanSwapchainOptions* options);
+
 /**
    Vulkan graphics backend.
 
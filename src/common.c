@@ -12,7 +12,6 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
-#include <string.h>
 
 const char*
 puglStrerror(const PuglStatus status)
@@ -125,6 +124,11 @@ puglSetDefaultHints(PuglView* const view)
   view->hints[PUGL_REFRESH_RATE]          = PUGL_DONT_CARE;
   view->hints[PUGL_VIEW_TYPE]             = PUGL_DONT_CARE;
   view->hints[PUGL_ACCEPT_DROP]           = PUGL_DONT_CARE;
+  view->hints[PUGL_COALESCE_CONFIGURE]    = PUGL_FALSE;
+  view->hints[PUGL_COALESCE_POINTER]      = PUGL_FALSE;
+  view->hints[PUGL_PRESERVE_CONTENTS]     = PUGL_FALSE;
+  view->hints[PUGL_SURFACE_TYPE]          = PUGL_DONT_CARE;
+  view->hints[PUGL_RENDER_THREAD]         = PUGL_FALSE;
 
   for (unsigned i = 0U; i < PUGL_NUM_POSITION_HINTS; ++i) {
     view->positionHints[i].x = INT16_MIN;
@@ -140,6 +144,20 @@ puglSetDefaultHints(PuglView* const view)
 PuglView*
 puglNewView(PuglWorld* const world)
 {
+  // Enlarge world view list if necessary (amortized by doubling)
+  if (world->numViews == world->maxViews) {
+    const size_t     newMaxViews = world->maxViews ? world->maxViews * 2U : 8U;
+    PuglView** const views =
+      (PuglView**)realloc(world->views, newMaxViews * sizeof(PuglView*));
+
+    if (!views) {
+      return NULL;
+    }
+
+    world->views    = views;
+    world->maxViews = newMaxViews;
+  }
+
   PuglView* view = (PuglView*)calloc(1, sizeof(PuglView));
   if (!view || !(view->impl = puglInitViewInternals(world))) {
     free(view);
@@ -149,20 +167,10 @@ puglNewView(PuglWorld* const world)
   view->world = world;
   puglSetDefaultHints(view);
 
-  // Enlarge world view list
-  const size_t     newNumViews = world->numViews + 1U;
-  PuglView** const views =
-    (PuglView**)realloc(world->views, newNumViews * sizeof(PuglView*));
-
-  if (!views) {
-    free(view);
-    return NULL;
-  }
-
   // Add to world view list
-  world->views                  = views;
+  view->index                   = world->numViews;
   world->views[world->numViews] = view;
-  world->numViews               = newNumViews;
+  ++world->numViews;
 
   return view;
 }
@@ -170,19 +178,18 @@ puglNewView(PuglWorld* const world)
 void
 puglFreeView(PuglView* view)
 {
-  // Remove from world view list
-  PuglWorld* world = view->world;
-  for (size_t i = 0; i < world->numViews; ++i) {
-    if (world->views[i] == view) {
-      if (i == world->numViews - 1) {
-        world->views[i] = NULL;
-      } else {
-        memmove(world->views + i,
-                world->views + i + 1,
-                sizeof(PuglView*) * (world->numViews - i - 1));
-        world->views[world->numViews - 1] = NULL;
-      }
-      --world->numViews;
+  // Remove from world view list by moving the last view into its slot
+  PuglWorld* const world = view->world;
+  PuglView* const  last  = world->views[world->numViews - 1U];
+
+  last->index                     = view->index;
+  world->views[view->index]       = last;
+  world->views[--world->numViews] = NULL;
+
+  // Forget this view in any views that were going to share its context
+  for (size_t i = 0U; i < world->numViews; ++i) {
+    if (world->views[i]->sharedView == view) {
+      world->views[i]->sharedView = NULL;
     }
   }
 
@@ -190,6 +197,7 @@ puglFreeView(PuglView* view)
     free(view->strings[i]);
   }
 
+  free(view->motionHistory);
   puglFreeViewInternals(view);
   free(view);
 }
@@ -352,6 +360,21 @@ puglSetParent(PuglView* view, PuglNativeView parent)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglSetSharedView(PuglView* const view, PuglView* const other)
+{
+  if (view->stage != PUGL_VIEW_STAGE_ALLOCATED) {
+    return PUGL_FAILURE;
+  }
+
+  if (other && (other == view || other->world != view->world)) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  view->sharedView = other;
+  return PUGL_SUCCESS;
+}
+
 PuglStatus
 puglSetSizeHint(PuglView* const    view,
                 const PuglSizeHint hint,
@@ -396,3 +419,17 @@ puglGetViewStyle(const PuglView* const view)
 {
   return view->lastConfigure.style;
 }
+
+const PuglMotionEvent*
+puglGetMotionHistory(const PuglView* const view, size_t* const count)
+{
+  *count = view->numMotions;
+  return view->numMotions ? view->motionHistory : NULL;
+}
+
+const PuglRect*
+puglGetExposeRects(const PuglView* const view, size_t* const count)
+{
+  *count = view->numExposeRects;
+  return view->numExposeRects ? view->exposeRects : NULL;
+}
@@ -252,6 +252,47 @@ puglPreRealize(PuglView* const view)
                                                      : PUGL_SUCCESS;
 }
 
+PuglStatus
+puglAppendMotionHistory(PuglView* const              view,
+                        const PuglMotionEvent* const motion)
+{
+  if (view->numMotions == view->maxMotions) {
+    const size_t newMaxMotions = view->maxMotions ? view->maxMotions * 2U : 16U;
+    PuglMotionEvent* const motions = (PuglMotionEvent*)realloc(
+      view->motionHistory, newMaxMotions * sizeof(PuglMotionEvent));
+
+    if (!motions) {
+      return PUGL_NO_MEMORY;
+    }
+
+    view->motionHistory = motions;
+    view->maxMotions    = newMaxMotions;
+  }
+
+  view->motionHistory[view->numMotions++] = *motion;
+  return PUGL_SUCCESS;
+}
+
+/// Dispatch `event` to `view` in its graphics context, if it's not threaded
+static PuglStatus
+puglDispatchInContext(PuglView* const view, const PuglEvent* const event)
+{
+  /* The context may be current on the render thread, which entering it here
+     would conflict with, so the application manages it on that thread. */
+  if (view->hints[PUGL_RENDER_THREAD] == PUGL_TRUE) {
+    return view->eventFunc(view, event);
+  }
+
+  PuglStatus st0 = PUGL_SUCCESS;
+  PuglStatus st1 = PUGL_SUCCESS;
+  if (!(st0 = view->backend->enter(view, NULL))) {
+    st0 = view->eventFunc(view, event);
+    st1 = view->backend->leave(view, NULL);
+  }
+
+  return st0 ? st0 : st1;
+}
+
 PuglStatus
 puglDispatchSimpleEvent(PuglView* view, const PuglEventType type)
 {
@@ -275,19 +316,13 @@ puglDispatchEvent(PuglView* view, const PuglEvent* event)
 
   case PUGL_REALIZE:
     assert(view->stage == PUGL_VIEW_STAGE_ALLOCATED);
-    if (!(st0 = view->backend->enter(view, NULL))) {
-      st0 = view->eventFunc(view, event);
-      st1 = view->backend->leave(view, NULL);
-    }
+    st0         = puglDispatchInContext(view, event);
     view->stage = PUGL_VIEW_STAGE_REALIZED;
     break;
 
   case PUGL_UNREALIZE:
     assert(view->stage >= PUGL_VIEW_STAGE_REALIZED);
-    if (!(st0 = view->backend->enter(view, NULL))) {
-      st0 = view->eventFunc(view, event);
-      st1 = view->backend->leave(view, NULL);
-    }
+    st0         = puglDispatchInContext(view, event);
     view->stage = PUGL_VIEW_STAGE_ALLOCATED;
     break;
 
@@ -60,6 +60,10 @@ puglStoreSizeHint(PuglView*    view,
                   unsigned     width,
                   unsigned     height);
 
+/// Set the view that a graphics backend shares resources with
+PUGL_API PuglStatus
+puglSetSharedView(PuglView* view, PuglView* other);
+
 /// Apply a change to a string property
 PuglStatus
 puglApplyViewString(PuglView* view, PuglStringHint key, const char* value);
@@ -76,12 +80,16 @@ puglFilterMods(PuglMods state, PuglKey key);
 PuglStatus
 puglPreRealize(PuglView* view);
 
+/// Append `motion` to the motion history of `view`, growing it if necessary
+PuglStatus
+puglAppendMotionHistory(PuglView* view, const PuglMotionEvent* motion);
+
 /// Dispatch an event with a simple `type` to `view`
 PuglStatus
 puglDispatchSimpleEvent(PuglView* view, PuglEventType type);
 
 /// Dispatch `event` to `view`, entering graphics context if necessary
-PuglStatus
+PUGL_API PuglStatus
 puglDispatchEvent(PuglView* view, const PuglEvent* event);
 
 PUGL_END_DECLS
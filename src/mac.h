@@ -23,9 +23,13 @@
 @interface PuglWindow : NSWindow
 @end
 
+@interface PuglPostTarget : NSObject
+@end
+
 struct PuglWorldInternalsImpl {
   NSApplication*            app;
   NSAutoreleasePool*        autoreleasePool;
+  PuglPostTarget*           postTarget;
   struct mach_timebase_info timebaseInfo;
 };
 
@@ -1153,6 +1153,13 @@ flagDiffers(const uint32_t lhs, const uint32_t rhs, const uint32_t mask)
 
 @end
 
+/// A flag shared with posted events, cleared when the world is freed
+@implementation PuglPostTarget {
+@public
+  bool valid;
+}
+@end
+
 PuglWorldInternals*
 puglInitWorldInternals(PuglWorldType type, PuglWorldFlags PUGL_UNUSED(flags))
 {
@@ -1165,6 +1172,9 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags PUGL_UNUSED(flags))
     return NULL;
   }
 
+  impl->postTarget        = [PuglPostTarget new];
+  impl->postTarget->valid = true;
+
   if (type == PUGL_PROGRAM) {
     impl->autoreleasePool = [NSAutoreleasePool new];
 
@@ -1177,6 +1187,10 @@ puglInitWorldInternals(PuglWorldType type, PuglWorldFlags PUGL_UNUSED(flags))
 void
 puglFreeWorldInternals(PuglWorld* world)
 {
+  // Invalidate any posted events that haven't been dispatched yet
+  world->impl->postTarget->valid = false;
+  [world->impl->postTarget release];
+
   if (world->impl->autoreleasePool) {
     [world->impl->autoreleasePool drain];
   }
@@ -1701,6 +1715,31 @@ puglSendEvent(PuglView* view, const PuglEvent* event)
   return PUGL_UNSUPPORTED;
 }
 
+PuglStatus
+puglPostClientEvent(PuglView* const view,
+                    const uintptr_t data1,
+                    const uintptr_t data2)
+{
+  PuglWorld* const      world  = view->world;
+  PuglPostTarget* const target = world->impl->postTarget;
+
+  // The block retains the target, which outlives the world if necessary
+  dispatch_async(dispatch_get_main_queue(), ^{
+    // Discard the event if the world or view has been freed since it was posted
+    for (size_t i = 0U; target->valid && i < world->numViews; ++i) {
+      if (world->views[i] == view) {
+        PuglEvent event    = {{PUGL_CLIENT, 0U}};
+        event.client.data1 = data1;
+        event.client.data2 = data2;
+        puglDispatchEvent(view, &event);
+        break;
+      }
+    }
+  });
+
+  return PUGL_SUCCESS;
+}
+
 PuglStatus
 puglUpdate(PuglWorld* world, const double timeout)
 {
@@ -1747,6 +1786,70 @@ puglUpdate(PuglWorld* world, const double timeout)
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglWatchFd(PuglWorld* const     world,
+            const int            fd,
+            const PuglWatchFlags flags,
+            const PuglWatchFunc  func,
+            void* const          data)
+{
+  (void)world;
+  (void)fd;
+  (void)flags;
+  (void)func;
+  (void)data;
+  return PUGL_UNSUPPORTED;
+}
+
+PuglStatus
+puglUnwatchFd(PuglWorld* const world, const int fd)
+{
+  (void)world;
+  (void)fd;
+  return PUGL_UNSUPPORTED;
+}
+
+int
+puglGetWorldFd(const PuglWorld* const world)
+{
+  (void)world;
+  return -1;
+}
+
+int
+puglGetWakeFd(const PuglWorld* const world)
+{
+  (void)world;
+  return -1;
+}
+
+double
+puglGetNextDeadline(const PuglWorld* const world)
+{
+  return puglGetTime(world);
+}
+
+PuglStatus
+puglPrepareUpdate(PuglWorld* const world, double* const timeout)
+{
+  (void)world;
+  *timeout = 0.0;
+  return PUGL_UNSUPPORTED;
+}
+
+bool
+puglCheckUpdate(PuglWorld* const world)
+{
+  (void)world;
+  return true;
+}
+
+PuglStatus
+puglDispatchUpdate(PuglWorld* const world)
+{
+  return puglUpdate(world, 0.0);
+}
+
 double
 puglGetTime(const PuglWorld* world)
 {
@@ -1801,6 +1904,23 @@ puglObscureRegion(PuglView*      view,
   return PUGL_SUCCESS;
 }
 
+PuglStatus
+puglScrollRegion(PuglView*      view,
+                 const int      x,
+                 const int      y,
+                 const unsigned width,
+                 const unsigned height,
+                 const int      dx,
+                 const int      dy)
+{
+  if (!puglIsValidPosition(dx, dy)) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  // Contents aren't moved here, so redraw the whole region
+  return puglObscureRegion(view, x, y, width, height);
+}
+
 PuglNativeView
 puglGetNativeView(const PuglView* view)
 {
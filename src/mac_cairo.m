@@ -142,7 +142,8 @@ puglCairoBackend(void)
                                       puglMacCairoDestroy,
                                       puglMacCairoEnter,
                                       puglMacCairoLeave,
-                                      puglMacCairoGetContext};
+                                      puglMacCairoGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
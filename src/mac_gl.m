@@ -1,4 +1,4 @@
-// Copyright 2019-2022 David Robillard <d@drobilla.net>
+// Copyright 2019-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #include "internal.h"
@@ -27,7 +27,7 @@ ensureHint(PuglView* const view, const PuglViewHint hint, const int value)
   PuglView* puglview;
 }
 
-- (id)initWithFrame:(NSRect)frame
+- (id)initWithFrame:(NSRect)frame shareContext:(NSOpenGLContext*)shareContext
 {
   const bool compat =
     puglview->hints[PUGL_CONTEXT_PROFILE] == PUGL_OPENGL_COMPATIBILITY_PROFILE;
@@ -72,11 +72,22 @@ ensureHint(PuglView* const view, const PuglViewHint hint, const int value)
 
   if (pixelFormat) {
     self = [super initWithFrame:frame pixelFormat:pixelFormat];
-    [pixelFormat release];
   } else {
     self = [super initWithFrame:frame];
   }
 
+  // Replace the context with one that shares resources, if necessary
+  if (self && shareContext) {
+    NSOpenGLContext* const context =
+      [[NSOpenGLContext alloc] initWithFormat:[self pixelFormat]
+                                 shareContext:shareContext];
+
+    [self setOpenGLContext:context];
+    [context release];
+  }
+
+  [pixelFormat release];
+
   [self setWantsBestResolutionOpenGLSurface:YES];
 
   if (self) {
@@ -106,17 +117,32 @@ ensureHint(PuglView* const view, const PuglViewHint hint, const int value)
 static PuglStatus
 puglMacGlCreate(PuglView* view)
 {
-  PuglInternals*  impl     = view->impl;
+  PuglInternals* impl = view->impl;
+
+  // Get the context to share resources with, if any
+  NSOpenGLContext* share = nil;
+  if (view->sharedView) {
+    const PuglView* const other = view->sharedView;
+    if (other->backend != view->backend || !other->impl->drawView) {
+      return PUGL_BAD_CONFIGURATION;
+    }
+
+    share = [(PuglOpenGLView*)other->impl->drawView openGLContext];
+  }
+
   PuglOpenGLView* drawView = [PuglOpenGLView alloc];
 
   drawView->puglview = view;
-  [drawView initWithFrame:[impl->wrapperView bounds]];
+  [drawView initWithFrame:[impl->wrapperView bounds] shareContext:share];
   if (view->hints[PUGL_RESIZABLE]) {
     [drawView setAutoresizingMask:NSViewWidthSizable | NSViewHeightSizable];
   } else {
     [drawView setAutoresizingMask:NSViewNotSizable];
   }
 
+  // Rendering on another thread isn't supported
+  view->hints[PUGL_RENDER_THREAD] = PUGL_FALSE;
+
   impl->drawView = drawView;
   return PUGL_SUCCESS;
 }
@@ -175,6 +201,30 @@ puglGetProcAddress(const char* name)
   return func;
 }
 
+PuglStatus
+puglSwapBuffers(PuglView* const view)
+{
+  PuglOpenGLView* const drawView = (PuglOpenGLView*)view->impl->drawView;
+  if (!drawView) {
+    return PUGL_FAILURE;
+  }
+
+  [[drawView openGLContext] flushBuffer];
+  return PUGL_SUCCESS;
+}
+
+unsigned
+puglGetBufferAge(const PuglView* PUGL_UNUSED(view))
+{
+  return 0U;
+}
+
+PuglStatus
+puglSetSharedContext(PuglView* const view, PuglView* const other)
+{
+  return puglSetSharedView(view, other);
+}
+
 PuglStatus
 puglEnterContext(PuglView* view)
 {
@@ -195,7 +245,8 @@ puglGlBackend(void)
                                       puglMacGlDestroy,
                                       puglMacGlEnter,
                                       puglMacGlLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
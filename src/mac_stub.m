@@ -75,7 +75,8 @@ puglStubBackend(void)
                                       puglMacStubDestroy,
                                       puglStubEnter,
                                       puglStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
@@ -54,6 +54,19 @@ puglStubGetContext(PuglView* const view)
   return NULL;
 }
 
+static inline PuglStatus
+puglStubScroll(PuglView* const view,
+               const PuglRect  rect,
+               const int       dx,
+               const int       dy)
+{
+  (void)view;
+  (void)rect;
+  (void)dx;
+  (void)dy;
+  return PUGL_UNSUPPORTED;
+}
+
 PUGL_END_DECLS
 
 #endif // PUGL_SRC_STUB_H
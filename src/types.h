@@ -1,4 +1,4 @@
-// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #ifndef PUGL_SRC_TYPES_H
@@ -51,12 +51,19 @@ struct PuglViewImpl {
   PuglEventFunc      eventFunc;
   PuglNativeView     parent;
   uintptr_t          transientParent;
+  PuglView*          sharedView;
   PuglConfigureEvent lastConfigure;
   PuglHints          hints;
   PuglPoint          positionHints[PUGL_NUM_POSITION_HINTS];
   PuglArea           sizeHints[PUGL_NUM_SIZE_HINTS];
   char*              strings[PUGL_NUM_STRING_HINTS];
+  PuglMotionEvent*   motionHistory;
+  size_t             numMotions;
+  size_t             maxMotions;
+  const PuglRect*    exposeRects;
+  size_t             numExposeRects;
   PuglViewStage      stage;
+  size_t             index;
   bool               resizing;
 };
 
@@ -66,6 +73,7 @@ struct PuglWorldImpl {
   void*               handle;
   double              startTime;
   size_t              numViews;
+  size_t              maxViews;
   PuglView**          views;
   char*               strings[PUGL_NUM_STRING_HINTS];
   PuglWorldType       type;
@@ -96,6 +104,9 @@ struct PuglBackendImpl {
 
   /// Return the puglGetContext() handle for the application, if any
   void* (*getContext)(PuglView*);
+
+  /// Move drawn contents within a rectangle by an offset, if possible
+  PUGL_WARN_UNUSED_RESULT PuglStatus (*scroll)(PuglView*, PuglRect, int, int);
 };
 
 #endif // PUGL_SRC_TYPES_H
@@ -1128,6 +1128,19 @@ puglSendEvent(PuglView* view, const PuglEvent* event)
   return PUGL_UNSUPPORTED;
 }
 
+PuglStatus
+puglPostClientEvent(PuglView* const view,
+                    const uintptr_t data1,
+                    const uintptr_t data2)
+{
+  PuglEvent event    = {{PUGL_CLIENT, 0U}};
+  event.client.data1 = data1;
+  event.client.data2 = data2;
+
+  // PostMessage() is thread-safe
+  return puglSendEvent(view, &event);
+}
+
 static PuglStatus
 puglDispatchViewEvents(const HWND hwnd)
 {
@@ -1219,6 +1232,70 @@ puglUpdate(PuglWorld* world, double timeout)
   return st;
 }
 
+PuglStatus
+puglWatchFd(PuglWorld* const     world,
+            const int            fd,
+            const PuglWatchFlags flags,
+            const PuglWatchFunc  func,
+            void* const          data)
+{
+  (void)world;
+  (void)fd;
+  (void)flags;
+  (void)func;
+  (void)data;
+  return PUGL_UNSUPPORTED;
+}
+
+PuglStatus
+puglUnwatchFd(PuglWorld* const world, const int fd)
+{
+  (void)world;
+  (void)fd;
+  return PUGL_UNSUPPORTED;
+}
+
+int
+puglGetWorldFd(const PuglWorld* const world)
+{
+  (void)world;
+  return -1;
+}
+
+int
+puglGetWakeFd(const PuglWorld* const world)
+{
+  (void)world;
+  return -1;
+}
+
+double
+puglGetNextDeadline(const PuglWorld* const world)
+{
+  return puglGetTime(world);
+}
+
+PuglStatus
+puglPrepareUpdate(PuglWorld* const world, double* const timeout)
+{
+  (void)world;
+  *timeout = 0.0;
+  return PUGL_UNSUPPORTED;
+}
+
+bool
+puglCheckUpdate(PuglWorld* const world)
+{
+  (void)world;
+  return true;
+}
+
+PuglStatus
+puglDispatchUpdate(PuglWorld* const world)
+{
+  return puglUpdate(world, 0.0);
+}
+
 LRESULT CALLBACK
 wndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 {
@@ -1283,6 +1360,23 @@ puglObscureRegion(PuglView* const view,
   return puglWinStatus(InvalidateRect(view->impl->hwnd, &r, false));
 }
 
+PuglStatus
+puglScrollRegion(PuglView* const view,
+                 const int       x,
+                 const int       y,
+                 const unsigned  width,
+                 const unsigned  height,
+                 const int       dx,
+                 const int       dy)
+{
+  if (!puglIsValidPosition(dx, dy)) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  // Contents aren't moved here, so redraw the whole region
+  return puglObscureRegion(view, x, y, width, height);
+}
+
 PuglNativeView
 puglGetNativeView(const PuglView* view)
 {
@@ -152,7 +152,8 @@ puglCairoBackend(void)
                                       puglWinCairoDestroy,
                                       puglWinCairoEnter,
                                       puglWinCairoLeave,
-                                      puglWinCairoGetContext};
+                                      puglWinCairoGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
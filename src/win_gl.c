@@ -1,6 +1,8 @@
-// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
+#include "attributes.h"
+#include "internal.h"
 #include "stub.h"
 #include "types.h"
 #include "win.h"
@@ -232,10 +234,26 @@ puglWinGlCreate(PuglView* view)
     return PUGL_SET_FORMAT_FAILED;
   }
 
+  // Get the context to share resources with, if any
+  HGLRC share = NULL;
+  if (view->sharedView) {
+    const PuglView* const         other = view->sharedView;
+    const PuglWinGlSurface* const otherSurface =
+      (other->backend == view->backend)
+        ? (const PuglWinGlSurface*)other->impl->surface
+        : NULL;
+
+    if (!otherSurface || !otherSurface->hglrc) {
+      return PUGL_BAD_CONFIGURATION;
+    }
+
+    share = otherSurface->hglrc;
+  }
+
   // Create GL context
   if (surface->procs.wglCreateContextAttribs &&
       !(surface->hglrc = surface->procs.wglCreateContextAttribs(
-          impl->hdc, 0, contextAttribs))) {
+          impl->hdc, share, contextAttribs))) {
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
@@ -243,6 +261,14 @@ puglWinGlCreate(PuglView* view)
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
+  // Share resources with the other context (before any are created here)
+  if (share && !wglShareLists(share, surface->hglrc)) {
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  // Rendering on another thread isn't supported
+  view->hints[PUGL_RENDER_THREAD] = PUGL_FALSE;
+
   // Enter context and set swap interval
   wglMakeCurrent(impl->hdc, surface->hglrc);
   const int swapInterval = view->hints[PUGL_SWAP_INTERVAL];
@@ -303,6 +329,32 @@ puglGetProcAddress(const char* name)
            : (PuglGlFunc)GetProcAddress(GetModuleHandleA("opengl32.dll"), name);
 }
 
+PuglStatus
+puglSwapBuffers(PuglView* const view)
+{
+  const PuglWinGlSurface* const surface =
+    (const PuglWinGlSurface*)view->impl->surface;
+
+  if (!surface || !surface->hglrc) {
+    return PUGL_FAILURE;
+  }
+
+  SwapBuffers(view->impl->hdc);
+  return PUGL_SUCCESS;
+}
+
+unsigned
+puglGetBufferAge(const PuglView* PUGL_UNUSED(view))
+{
+  return 0U;
+}
+
+PuglStatus
+puglSetSharedContext(PuglView* const view, PuglView* const other)
+{
+  return puglSetSharedView(view, other);
+}
+
 PuglStatus
 puglEnterContext(PuglView* view)
 {
@@ -323,7 +375,8 @@ puglGlBackend(void)
                                       puglWinGlDestroy,
                                       puglWinGlEnter,
                                       puglWinGlLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
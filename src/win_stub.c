@@ -33,7 +33,8 @@ puglStubBackend(void)
                                       puglStubDestroy,
                                       puglWinStubEnter,
                                       puglWinStubLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
@@ -1,4 +1,4 @@
-// Copyright 2012-2021 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #define VK_NO_PROTOTYPES 1
@@ -75,7 +75,8 @@ puglVulkanBackend(void)
                                       puglStubDestroy,
                                       puglWinEnter,
                                       puglWinLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
@@ -113,3 +114,45 @@ puglCreateSurface(PFN_vkGetInstanceProcAddr          vkGetInstanceProcAddr,
 
   return vkCreateWin32SurfaceKHR(instance, &createInfo, pAllocator, pSurface);
 }
+
+const char* const*
+puglGetHeadlessInstanceExtensions(uint32_t* const count)
+{
+  static const char* const extensions[] = {"VK_KHR_surface",
+                                           "VK_EXT_headless_surface"};
+
+  *count = 2;
+  return extensions;
+}
+
+VkResult
+puglCreateHeadlessSurface(PFN_vkGetInstanceProcAddr    vkGetInstanceProcAddr,
+                          VkInstance                   instance,
+                          const VkAllocationCallbacks* allocator,
+                          VkSurfaceKHR*                surface)
+{
+  PFN_vkCreateHeadlessSurfaceEXT vkCreateHeadlessSurfaceEXT =
+    (PFN_vkCreateHeadlessSurfaceEXT)vkGetInstanceProcAddr(
+      instance, "vkCreateHeadlessSurfaceEXT");
+
+  if (!vkCreateHeadlessSurfaceEXT) {
+    return VK_ERROR_EXTENSION_NOT_PRESENT;
+  }
+
+  const VkHeadlessSurfaceCreateInfoEXT info = {
+    VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT,
+    NULL,
+    0,
+  };
+
+  return vkCreateHeadlessSurfaceEXT(instance, &info, allocator, surface);
+}
+
+PuglStatus
+puglSetVulkanSwapchain(PuglView*                         PUGL_UNUSED(view),
+                       PFN_vkGetInstanceProcAddr         PUGL_UNUSED(getProc),
+                       VkInstance                        PUGL_UNUSED(instance),
+                       const PuglVulkanSwapchainOptions* PUGL_UNUSED(options))
+{
+  return PUGL_UNSUPPORTED;
+}
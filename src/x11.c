@@ -3,6 +3,19 @@
 // Copyright 2011-2012 Ben Loftis, Harrison Consoles
 // SPDX-License-Identifier: ISC
 
+#ifndef USE_PPOLL
+#  ifdef __linux__
+#    define USE_PPOLL 1
+#  else
+#    define USE_PPOLL 0
+#  endif
+#endif
+
+// ppoll() isn't in POSIX.1-2008, so must be enabled before any includes
+#if USE_PPOLL && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
 #include "x11.h"
 
 #include "attributes.h"
@@ -29,14 +42,6 @@
 #  endif
 #endif
 
-#ifndef USE_XSYNC
-#  if __has_include(<X11/extensions/sync.h>)
-#    define USE_XSYNC 1
-#  else
-#    define USE_XSYNC 0
-#  endif
-#endif
-
 #ifndef USE_XCURSOR
 #  if __has_include(<X11/Xcursor/Xcursor.h>)
 #    define USE_XCURSOR 1
@@ -45,21 +50,33 @@
 #  endif
 #endif
 
+#ifndef USE_XPRESENT
+#  if __has_include(<X11/extensions/Xpresent.h>)
+#    define USE_XPRESENT 1
+#  else
+#    define USE_XPRESENT 0
+#  endif
+#endif
+
 #if USE_XRANDR
 #  include <X11/extensions/Xrandr.h>
 #endif
 
-#if USE_XSYNC
-#  include <X11/extensions/sync.h>
-#  include <X11/extensions/syncconst.h>
+#if USE_XPRESENT
+#  include <X11/extensions/Xfixes.h>
+#  include <X11/extensions/Xpresent.h>
 #endif
 
 #if USE_XCURSOR
 #  include <X11/Xcursor/Xcursor.h>
 #endif
 
-#include <sys/select.h>
+#ifdef __linux__
+#  include <sys/eventfd.h>
+#endif
 
+#include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <math.h>
 #include <stdbool.h>
@@ -85,6 +102,64 @@ enum WmClientStateMessageAction {
   WM_STATE_TOGGLE
 };
 
+/// Indices of the file descriptors at the start of the world's poll array
+enum PollFdIndex {
+  POLL_X11_FD,          ///< Connection to the X server
+  POLL_WAKE_FD,         ///< Read end of the wake pipe (or eventfd)
+  NUM_INTERNAL_POLL_FDS ///< Start of watched file descriptors
+};
+
+/// Size of the queue for events posted from other threads (a power of two)
+#define PUGL_NUM_POSTED_EVENTS 1024U
+
+/// Period in seconds to poll for presented frames that are overdue
+#define PUGL_PRESENT_POLL_PERIOD 0.002
+
+#define PUGL_NUM_X11_ATOMS (sizeof(PuglX11Atoms) / sizeof(Atom))
+
+/// Names of all atoms in PuglX11Atoms, in the same order as its fields
+static const char atomNames[PUGL_NUM_X11_ATOMS][32] = {
+  "CLIPBOARD",
+  "UTF8_STRING",
+  "WM_CLIENT_MACHINE",
+  "WM_PROTOCOLS",
+  "WM_DELETE_WINDOW",
+  "_PUGL_CLIENT_MSG",
+  "_NET_CLOSE_WINDOW",
+  "_NET_FRAME_EXTENTS",
+  "_NET_WM_NAME",
+  "_NET_WM_PID",
+  "_NET_WM_PING",
+  "_NET_WM_STATE",
+  "_NET_WM_STATE_ABOVE",
+  "_NET_WM_STATE_BELOW",
+  "_NET_WM_STATE_DEMANDS_ATTENTION",
+  "_NET_WM_STATE_FULLSCREEN",
+  "_NET_WM_STATE_HIDDEN",
+  "_NET_WM_STATE_MAXIMIZED_HORZ",
+  "_NET_WM_STATE_MAXIMIZED_VERT",
+  "_NET_WM_STATE_MODAL",
+  "_NET_WM_WINDOW_TYPE",
+  "_NET_WM_WINDOW_TYPE_DIALOG",
+  "_NET_WM_WINDOW_TYPE_NORMAL",
+  "_NET_WM_WINDOW_TYPE_UTILITY",
+  "TARGETS",
+  "XdndActionCopy",
+  "XdndActionLink",
+  "XdndActionMove",
+  "XdndActionPrivate",
+  "XdndAware",
+  "XdndDrop",
+  "XdndEnter",
+  "XdndFinished",
+  "XdndLeave",
+  "XdndPosition",
+  "XdndSelection",
+  "XdndStatus",
+  "XdndTypeList",
+  "text/uri-list",
+};
+
 #if USE_XCURSOR
 static const char* const cursorNames[PUGL_NUM_CURSORS] = {
   "default",           // ARROW
@@ -115,36 +190,6 @@ puglX11Status(const int returnCode)
   return returnCode ? PUGL_SUCCESS : PUGL_UNKNOWN_ERROR;
 }
 
-static bool
-initXSync(PuglWorldInternals* const impl)
-{
-#if USE_XSYNC
-  int                 syncMajor   = 0;
-  int                 syncMinor   = 0;
-  int                 errorBase   = 0;
-  XSyncSystemCounter* counters    = NULL;
-  int                 numCounters = 0;
-
-  if (XSyncQueryExtension(impl->display, &impl->syncEventBase, &errorBase) &&
-      XSyncInitialize(impl->display, &syncMajor, &syncMinor) &&
-      (counters = XSyncListSystemCounters(impl->display, &numCounters))) {
-    for (int n = 0; n < numCounters; ++n) {
-      if (!strcmp(counters[n].name, "SERVERTIME")) {
-        impl->serverTimeCounter = counters[n].counter;
-        impl->syncSupported     = true;
-        break;
-      }
-    }
-
-    XSyncFreeSystemCounterList(counters);
-  }
-#else
-  (void)impl;
-#endif
-
-  return false;
-}
-
 static double
 puglX11GetDisplayScaleFactor(Display* const display)
 {
@@ -172,6 +217,39 @@ puglX11GetDisplayScaleFactor(Display* const display)
   return dpi / 96.0;
 }
 
+/// Open a non-blocking eventfd, or pipe, to wake up the event loop
+static PuglStatus
+openWakeFds(int fds[2])
+{
+#ifdef __linux__
+  fds[0] = fds[1] = eventfd(0U, EFD_CLOEXEC | EFD_NONBLOCK);
+  return fds[0] < 0 ? PUGL_UNKNOWN_ERROR : PUGL_SUCCESS;
+#else
+  if (pipe(fds)) {
+    return PUGL_UNKNOWN_ERROR;
+  }
+
+  for (unsigned i = 0U; i < 2U; ++i) {
+    fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+  }
+
+  return PUGL_SUCCESS;
+#endif
+}
+
+static void
+closeWakeFds(const int fds[2])
+{
+  if (fds[0] >= 0) {
+    close(fds[0]);
+  }
+
+  if (fds[1] >= 0 && fds[1] != fds[0]) {
+    close(fds[1]);
+  }
+}
+
 PuglWorldInternals*
 puglInitWorldInternals(const PuglWorldType type, const PuglWorldFlags flags)
 {
@@ -188,63 +266,61 @@ puglInitWorldInternals(const PuglWorldType type, const PuglWorldFlags flags)
     (PuglWorldInternals*)calloc(1, sizeof(PuglWorldInternals));
 
   impl->display     = display;
+  impl->flags       = flags;
+  impl->viewContext = XUniqueContext();
   impl->scaleFactor = puglX11GetDisplayScaleFactor(display);
+  impl->wakeFds[0]  = -1;
+  impl->wakeFds[1]  = -1;
+
+  // Set up the queue for events posted from other threads and its wakeup
+  impl->pollFds = (struct pollfd*)calloc(NUM_INTERNAL_POLL_FDS,
+                                         sizeof(struct pollfd));
+  impl->posted  = (PuglPostedEvent*)calloc(PUGL_NUM_POSTED_EVENTS,
+                                          sizeof(PuglPostedEvent));
+  if (!impl->pollFds || !impl->posted || openWakeFds(impl->wakeFds)) {
+    closeWakeFds(impl->wakeFds);
+    free(impl->posted);
+    free(impl->pollFds);
+    free(impl);
+    XCloseDisplay(display);
+    return NULL;
+  }
+
+  for (size_t i = 0U; i < PUGL_NUM_POSTED_EVENTS; ++i) {
+    impl->posted[i].sequence = i;
+  }
+
+  impl->pollFds[POLL_X11_FD].fd      = ConnectionNumber(display);
+  impl->pollFds[POLL_X11_FD].events  = POLLIN;
+  impl->pollFds[POLL_WAKE_FD].fd     = impl->wakeFds[0];
+  impl->pollFds[POLL_WAKE_FD].events = POLLIN;
+
+  // Intern all the atoms we'll need in a single round trip
+  char  nameBuffers[PUGL_NUM_X11_ATOMS][32];
+  char* names[PUGL_NUM_X11_ATOMS] = {NULL};
+  Atom  atoms[PUGL_NUM_X11_ATOMS] = {0U};
+  memcpy(nameBuffers, atomNames, sizeof(atomNames));
+  for (size_t i = 0U; i < PUGL_NUM_X11_ATOMS; ++i) {
+    names[i] = nameBuffers[i];
+  }
+
+  XInternAtoms(display, names, (int)PUGL_NUM_X11_ATOMS, False, atoms);
+  memcpy(&impl->atoms, atoms, sizeof(atoms));
 
-  // Intern the various atoms we'll need
-
-  impl->atoms.CLIPBOARD         = XInternAtom(display, "CLIPBOARD", 0);
-  impl->atoms.UTF8_STRING       = XInternAtom(display, "UTF8_STRING", 0);
-  impl->atoms.WM_CLIENT_MACHINE = XInternAtom(display, "WM_CLIENT_MACHINE", 0);
-  impl->atoms.WM_PROTOCOLS      = XInternAtom(display, "WM_PROTOCOLS", 0);
-  impl->atoms.WM_DELETE_WINDOW  = XInternAtom(display, "WM_DELETE_WINDOW", 0);
-  impl->atoms.PUGL_CLIENT_MSG   = XInternAtom(display, "_PUGL_CLIENT_MSG", 0);
-  impl->atoms.NET_CLOSE_WINDOW  = XInternAtom(display, "_NET_CLOSE_WINDOW", 0);
-  impl->atoms.NET_FRAME_EXTENTS = XInternAtom(display, "_NET_FRAME_EXTENTS", 0);
-  impl->atoms.NET_WM_NAME       = XInternAtom(display, "_NET_WM_NAME", 0);
-  impl->atoms.NET_WM_PID        = XInternAtom(display, "_NET_WM_PID", 0);
-  impl->atoms.NET_WM_PING       = XInternAtom(display, "_NET_WM_PING", 0);
-  impl->atoms.NET_WM_STATE      = XInternAtom(display, "_NET_WM_STATE", 0);
-
-  impl->atoms.NET_WM_STATE_ABOVE =
-    XInternAtom(display, "_NET_WM_STATE_ABOVE", 0);
-  impl->atoms.NET_WM_STATE_BELOW =
-    XInternAtom(display, "_NET_WM_STATE_BELOW", 0);
-  impl->atoms.NET_WM_STATE_DEMANDS_ATTENTION =
-    XInternAtom(display, "_NET_WM_STATE_DEMANDS_ATTENTION", 0);
-  impl->atoms.NET_WM_STATE_FULLSCREEN =
-    XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", 0);
-  impl->atoms.NET_WM_STATE_HIDDEN =
-    XInternAtom(display, "_NET_WM_STATE_HIDDEN", 0);
-  impl->atoms.NET_WM_STATE_MAXIMIZED_HORZ =
-    XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_HORZ", 0);
-  impl->atoms.NET_WM_STATE_MAXIMIZED_VERT =
-    XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_VERT", 0);
-  impl->atoms.NET_WM_STATE_MODAL =
-    XInternAtom(display, "_NET_WM_STATE_MODAL", 0);
-  impl->atoms.NET_WM_WINDOW_TYPE =
-    XInternAtom(display, "_NET_WM_WINDOW_TYPE", 0);
-  impl->atoms.NET_WM_WINDOW_TYPE_DIALOG =
-    XInternAtom(display, "_NET_WM_WINDOW_TYPE_DIALOG", 0);
-  impl->atoms.NET_WM_WINDOW_TYPE_NORMAL =
-    XInternAtom(display, "_NET_WM_WINDOW_TYPE_NORMAL", 0);
-  impl->atoms.NET_WM_WINDOW_TYPE_UTILITY =
-    XInternAtom(display, "_NET_WM_WINDOW_TYPE_UTILITY", 0);
-
-  impl->atoms.TARGETS           = XInternAtom(display, "TARGETS", 0);
-  impl->atoms.XdndActionCopy    = XInternAtom(display, "XdndActionCopy", 0);
-  impl->atoms.XdndActionLink    = XInternAtom(display, "XdndActionLink", 0);
-  impl->atoms.XdndActionMove    = XInternAtom(display, "XdndActionMove", 0);
-  impl->atoms.XdndActionPrivate = XInternAtom(display, "XdndActionPrivate", 0);
-  impl->atoms.XdndAware         = XInternAtom(display, "XdndAware", 0);
-  impl->atoms.XdndDrop          = XInternAtom(display, "XdndDrop", 0);
-  impl->atoms.XdndEnter         = XInternAtom(display, "XdndEnter", 0);
-  impl->atoms.XdndFinished      = XInternAtom(display, "XdndFinished", 0);
-  impl->atoms.XdndLeave         = XInternAtom(display, "XdndLeave", 0);
-  impl->atoms.XdndPosition      = XInternAtom(display, "XdndPosition", 0);
-  impl->atoms.XdndSelection     = XInternAtom(display, "XdndSelection", 0);
-  impl->atoms.XdndStatus        = XInternAtom(display, "XdndStatus", 0);
-  impl->atoms.XdndTypeList      = XInternAtom(display, "XdndTypeList", 0);
-  impl->atoms.text_uri_list     = XInternAtom(display, "text/uri-list", 0);
+#if USE_XPRESENT
+  // Check for the Present extension, which needs XFixes for update regions
+  int opcode     = 0;
+  int eventBase  = 0;
+  int errorBase  = 0;
+  int fixesMajor = 2;
+  int fixesMinor = 0;
+  if (XPresentQueryExtension(display, &opcode, &eventBase, &errorBase) &&
+      XFixesQueryExtension(display, &eventBase, &errorBase) &&
+      XFixesQueryVersion(display, &fixesMajor, &fixesMinor) &&
+      fixesMajor >= 2) {
+    impl->presentOpcode = opcode;
+  }
+#endif
 
   // Open input method
   XSetLocaleModifiers("");
@@ -254,7 +330,6 @@ puglInitWorldInternals(const PuglWorldType type, const PuglWorldFlags flags)
   }
 
   XrmInitialize();
-  initXSync(impl);
   XFlush(display);
 
   return impl;
@@ -266,6 +341,160 @@ puglGetNativeWorld(PuglWorld* const world)
   return world->impl->display;
 }
 
+static void
+setHeapTimer(PuglWorldInternals* const w, const size_t i, PuglTimer* const t)
+{
+  w->timers[i] = t;
+  t->index     = i;
+}
+
+static void
+siftTimerUp(PuglWorldInternals* const w, size_t i)
+{
+  PuglTimer* const timer = w->timers[i];
+  while (i > 0U) {
+    const size_t parent = (i - 1U) / 2U;
+    if (w->timers[parent]->deadline <= timer->deadline) {
+      break;
+    }
+
+    setHeapTimer(w, i, w->timers[parent]);
+    i = parent;
+  }
+
+  setHeapTimer(w, i, timer);
+}
+
+static void
+siftTimerDown(PuglWorldInternals* const w, size_t i)
+{
+  PuglTimer* const timer = w->timers[i];
+  while ((2U * i) + 1U < w->numTimers) {
+    size_t child = (2U * i) + 1U;
+    if (child + 1U < w->numTimers &&
+        w->timers[child + 1U]->deadline < w->timers[child]->deadline) {
+      ++child;
+    }
+
+    if (timer->deadline <= w->timers[child]->deadline) {
+      break;
+    }
+
+    setHeapTimer(w, i, w->timers[child]);
+    i = child;
+  }
+
+  setHeapTimer(w, i, timer);
+}
+
+/// Restore the heap order after the deadline of the timer at `i` changed
+static void
+fixTimer(PuglWorldInternals* const w, const size_t i)
+{
+  if (i > 0U && w->timers[i]->deadline < w->timers[(i - 1U) / 2U]->deadline) {
+    siftTimerUp(w, i);
+  } else {
+    siftTimerDown(w, i);
+  }
+}
+
+/// Return the preferred slot for a timer `id` in a table with `mask`
+static size_t
+timerSlot(const uintptr_t id, const size_t mask)
+{
+  // Fibonacci hashing, to spread consecutive IDs across the table
+  return (size_t)(((uint64_t)id * 0x9E3779B97F4A7C15ULL) >> 32U) & mask;
+}
+
+/// Return the slot of the timer with `id` in a view's table, or a free slot
+static size_t
+findTimer(const PuglInternals* const impl, const uintptr_t id)
+{
+  const size_t mask = impl->maxTimers - 1U;
+  size_t       i    = timerSlot(id, mask);
+
+  while (impl->timers[i] && impl->timers[i]->id != id) {
+    i = (i + 1U) & mask;
+  }
+
+  return i;
+}
+
+/// Enlarge a view's timer table if necessary to add another timer
+static PuglStatus
+reserveTimer(PuglInternals* const impl)
+{
+  // Keep the table at most half full, so probe sequences stay short
+  if (2U * (impl->numTimers + 1U) <= impl->maxTimers) {
+    return PUGL_SUCCESS;
+  }
+
+  const size_t      newMaxTimers = impl->maxTimers ? impl->maxTimers * 2U : 8U;
+  const size_t      mask         = newMaxTimers - 1U;
+  PuglTimer** const timers =
+    (PuglTimer**)calloc(newMaxTimers, sizeof(PuglTimer*));
+
+  if (!timers) {
+    return PUGL_NO_MEMORY;
+  }
+
+  // Rehash every timer into the new table
+  for (size_t i = 0U; i < impl->maxTimers; ++i) {
+    PuglTimer* const timer = impl->timers[i];
+    if (timer) {
+      size_t j = timerSlot(timer->id, mask);
+      while (timers[j]) {
+        j = (j + 1U) & mask;
+      }
+
+      timers[j] = timer;
+    }
+  }
+
+  free(impl->timers);
+  impl->timers    = timers;
+  impl->maxTimers = newMaxTimers;
+  return PUGL_SUCCESS;
+}
+
+/// Remove a timer from the world heap and free it
+static void
+freeTimer(PuglWorldInternals* const w, PuglTimer* const timer)
+{
+  // Move the last timer into its place
+  PuglTimer* const last = w->timers[--w->numTimers];
+  if (last != timer) {
+    setHeapTimer(w, timer->index, last);
+    fixTimer(w, last->index);
+  }
+
+  free(timer);
+}
+
+/// Remove and free the timer in slot `i` of a view's timer table
+static void
+removeTimer(PuglView* const view, const size_t i)
+{
+  PuglInternals* const impl = view->impl;
+  const size_t         mask = impl->maxTimers - 1U;
+
+  freeTimer(view->world->impl, impl->timers[i]);
+
+  /* Fill the hole by shifting back any later timers in the same probe
+     sequence that can move into it, so lookups never stop early. */
+  size_t hole = i;
+  for (size_t j = (i + 1U) & mask; impl->timers[j]; j = (j + 1U) & mask) {
+    const size_t home = timerSlot(impl->timers[j]->id, mask);
+    if (((j - home) & mask) >= ((j - hole) & mask)) {
+      impl->timers[hole] = impl->timers[j];
+      hole               = j;
+    }
+  }
+
+  impl->timers[hole] = NULL;
+  --impl->numTimers;
+}
+
 PuglInternals*
 puglInitViewInternals(PuglWorld* const world)
 {
@@ -379,25 +608,29 @@ puglSetViewStyle(PuglView* const view, const PuglViewStyleFlags flags)
 static PuglStatus
 pollX11Socket(PuglWorld* const world, const double timeout)
 {
-  if (XPending(world->impl->display) > 0) {
+  PuglWorldInternals* const w       = world->impl;
+  Display* const            display = w->display;
+  const bool                pending = XPending(display) > 0;
+  if (pending && !w->numWatches) {
     return PUGL_SUCCESS;
   }
 
-  const int fd   = ConnectionNumber(world->impl->display);
-  const int nfds = fd + 1;
-  int       ret  = 0;
-  fd_set    fds;
-  FD_ZERO(&fds); // NOLINT
-  FD_SET(fd, &fds);
+  const nfds_t nfds = (nfds_t)(NUM_INTERNAL_POLL_FDS + w->numWatches);
 
-  if (timeout < 0.0) {
-    ret = select(nfds, &fds, NULL, NULL, NULL);
-  } else {
-    const long     sec  = (long)timeout;
-    const long     usec = (long)((timeout - (double)sec) * 1e6);
-    struct timeval tv   = {sec, usec};
-    ret                 = select(nfds, &fds, NULL, NULL, &tv);
-  }
+#if USE_PPOLL
+  // Wait for the precise timeout if nothing is pending
+  const double          wait = pending ? 0.0 : MIN(timeout, (double)INT_MAX);
+  const double          secs = floor(wait);
+  const struct timespec ts   = {(time_t)secs, (long)((wait - secs) * 1e9)};
+
+  const int ret = ppoll(w->pollFds, nfds, (wait < 0.0) ? NULL : &ts, NULL);
+#else
+  // Wait for the timeout (rounded up to milliseconds) if nothing is pending
+  const double ms        = MIN(ceil(timeout * 1e3), (double)INT_MAX);
+  const int    timeoutMs = pending ? 0 : (timeout < 0.0) ? -1 : (int)ms;
+
+  const int ret = poll(w->pollFds, nfds, timeoutMs);
+#endif
 
   return ret < 0 ? PUGL_UNKNOWN_ERROR : PUGL_SUCCESS;
 }
@@ -405,13 +638,12 @@ pollX11Socket(PuglWorld* const world, const double timeout)
 static PuglView*
 findView(PuglWorld* const world, const Window window)
 {
-  for (size_t i = 0; i < world->numViews; ++i) {
-    if (world->views[i]->impl->win == window) {
-      return world->views[i];
-    }
-  }
-
-  return NULL;
+  // Look up the view in the window context table (an Xlib hash table)
+  XPointer view = NULL;
+  return XFindContext(
+           world->impl->display, window, world->impl->viewContext, &view)
+           ? NULL
+           : (PuglView*)view;
 }
 
 static PuglStatus
@@ -630,6 +862,16 @@ puglRealize(PuglView* const view)
                             CWColormap | CWEventMask,
                             &attr);
 
+  // Register the window so events can be mapped back to this view
+  XSaveContext(display, impl->win, world->impl->viewContext, (XPointer)view);
+
+  // Initialize the configuration which is tracked from events from now on
+  impl->configuration.type   = PUGL_CONFIGURE;
+  impl->configuration.x      = initialPos.x;
+  impl->configuration.y      = initialPos.y;
+  impl->configuration.width  = initialSize.width;
+  impl->configuration.height = initialSize.height;
+
   // Create the backend drawing context/surface
   if ((st = view->backend->create(view))) {
     return st;
@@ -753,6 +995,8 @@ puglUnrealize(PuglView* const view)
   }
 
   if (view->world->impl->display && impl->win) {
+    XDeleteContext(
+      view->world->impl->display, impl->win, view->world->impl->viewContext);
     XDestroyWindow(view->world->impl->display, impl->win);
     impl->win = None;
   }
@@ -761,7 +1005,18 @@ puglUnrealize(PuglView* const view)
   impl->vi = NULL;
 
   memset(&view->lastConfigure, 0, sizeof(PuglConfigureEvent));
+  memset(&impl->configuration, 0, sizeof(PuglConfigureEvent));
+  memset(&impl->pendingConfigure, 0, sizeof(PuglEvent));
+  memset(&impl->pendingPointer, 0, sizeof(PuglEvent));
+  view->numMotions = 0U;
   memset(&view->impl->pendingExpose, 0, sizeof(PuglEvent));
+  impl->numDamageRects = 0U;
+  impl->numBusyPixmaps = 0U;
+  impl->presentEventId = 0U;
+  impl->presentPending = false;
+  impl->frameOffsetX   = 0;
+  impl->frameOffsetY   = 0;
+  impl->reparented     = false;
   return PUGL_SUCCESS;
 }
 
@@ -806,6 +1061,31 @@ puglFreeViewInternals(PuglView* const view)
 {
   if (view && view->impl) {
     puglUnrealize(view);
+    for (size_t i = 0U; i < view->impl->maxTimers; ++i) {
+      if (view->impl->timers[i]) {
+        freeTimer(view->world->impl, view->impl->timers[i]);
+      }
+    }
+
+    PuglWorldInternals* const w = view->world->impl;
+
+    const size_t tail = __atomic_load_n(&w->postTail, __ATOMIC_ACQUIRE);
+
+    /* Discard any posted events for this view that haven't been dispatched.
+       Every claimed cell is checked, waiting for any that another thread is
+       still filling in, since later cells may already be published. */
+    for (size_t pos = w->postHead; pos != tail; ++pos) {
+      PuglPostedEvent* const cell =
+        &w->posted[pos & (PUGL_NUM_POSTED_EVENTS - 1U)];
+      while (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != pos + 1U) {
+      }
+
+      if (cell->view == view) {
+        cell->view = NULL;
+      }
+    }
+
+    free(view->impl->timers);
     free(view->impl->clipboard.data.data);
     free(view->impl->clipboard.formats);
     free(view->impl->clipboard.formatStrings);
@@ -819,8 +1099,19 @@ puglFreeWorldInternals(PuglWorld* const world)
   if (world->impl->xim) {
     XCloseIM(world->impl->xim);
   }
+  if (world->impl->freeGlCache) {
+    world->impl->freeGlCache(world->impl->display, world->impl->glCache);
+  }
   XCloseDisplay(world->impl->display);
+  for (size_t i = 0U; i < world->impl->numTimers; ++i) {
+    free(world->impl->timers[i]);
+  }
+
+  closeWakeFds(world->impl->wakeFds);
   free(world->impl->timers);
+  free(world->impl->watches);
+  free(world->impl->pollFds);
+  free(world->impl->posted);
   free(world->impl);
 }
 
@@ -1199,93 +1490,142 @@ translateClientMessage(PuglView* const view, XClientMessageEvent message)
   return event;
 }
 
-static PuglViewStyleFlags
-getCurrentViewStyleFlags(PuglView* const view)
+static PuglStatus
+getWmStateFlags(PuglView* const view, PuglViewStyleFlags* const flags)
 {
   const PuglX11Atoms* const atoms = &view->world->impl->atoms;
 
-  unsigned long      numHints = 0;
-  Atom*              hints    = NULL;
-  PuglViewStyleFlags state    = 0U;
-  if (!getAtomProperty(
+  unsigned long numHints = 0;
+  Atom*         hints    = NULL;
+  if (getAtomProperty(
         view, view->impl->win, atoms->NET_WM_STATE, &numHints, &hints)) {
-    for (unsigned long i = 0; i < numHints; ++i) {
-      if (hints[i] == atoms->NET_WM_STATE_MAXIMIZED_VERT) {
-        state |= PUGL_VIEW_STYLE_TALL;
-      } else if (hints[i] == atoms->NET_WM_STATE_MAXIMIZED_HORZ) {
-        state |= PUGL_VIEW_STYLE_WIDE;
-      } else if (hints[i] == atoms->NET_WM_STATE_HIDDEN) {
-        state |= PUGL_VIEW_STYLE_HIDDEN;
-      } else if (hints[i] == atoms->NET_WM_STATE_FULLSCREEN) {
-        state |= PUGL_VIEW_STYLE_FULLSCREEN;
-      } else if (hints[i] == atoms->NET_WM_STATE_MODAL) {
-        state |= PUGL_VIEW_STYLE_MODAL;
-      } else if (hints[i] == atoms->NET_WM_STATE_ABOVE) {
-        state |= PUGL_VIEW_STYLE_ABOVE;
-      } else if (hints[i] == atoms->NET_WM_STATE_BELOW) {
-        state |= PUGL_VIEW_STYLE_BELOW;
-      } else if (hints[i] == atoms->NET_WM_STATE_DEMANDS_ATTENTION) {
-        state |= PUGL_VIEW_STYLE_DEMANDING;
-      }
+    return PUGL_FAILURE;
+  }
+
+  PuglViewStyleFlags state = 0U;
+  for (unsigned long i = 0; i < numHints; ++i) {
+    if (hints[i] == atoms->NET_WM_STATE_MAXIMIZED_VERT) {
+      state |= PUGL_VIEW_STYLE_TALL;
+    } else if (hints[i] == atoms->NET_WM_STATE_MAXIMIZED_HORZ) {
+      state |= PUGL_VIEW_STYLE_WIDE;
+    } else if (hints[i] == atoms->NET_WM_STATE_HIDDEN) {
+      state |= PUGL_VIEW_STYLE_HIDDEN;
+    } else if (hints[i] == atoms->NET_WM_STATE_FULLSCREEN) {
+      state |= PUGL_VIEW_STYLE_FULLSCREEN;
+    } else if (hints[i] == atoms->NET_WM_STATE_MODAL) {
+      state |= PUGL_VIEW_STYLE_MODAL;
+    } else if (hints[i] == atoms->NET_WM_STATE_ABOVE) {
+      state |= PUGL_VIEW_STYLE_ABOVE;
+    } else if (hints[i] == atoms->NET_WM_STATE_BELOW) {
+      state |= PUGL_VIEW_STYLE_BELOW;
+    } else if (hints[i] == atoms->NET_WM_STATE_DEMANDS_ATTENTION) {
+      state |= PUGL_VIEW_STYLE_DEMANDING;
     }
-    XFree(hints);
   }
 
-  if (view->impl->mapped) {
-    state |= PUGL_VIEW_STYLE_MAPPED;
+  if (hints) {
+    XFree(hints);
   }
 
-  return state;
+  *flags = state;
+  return PUGL_SUCCESS;
 }
 
+/// Return a configure event for the current (cached) window configuration
 static PuglEvent
-getCurrentConfiguration(PuglView* const view)
+getCurrentConfiguration(const PuglView* const view)
 {
-  Display* const display = view->world->impl->display;
+  const PuglInternals* const impl = view->impl;
+
+  PuglEvent configureEvent = {{PUGL_CONFIGURE, 0U}};
+  configureEvent.configure = impl->configuration;
+  if (impl->mapped) {
+    configureEvent.configure.style |= PUGL_VIEW_STYLE_MAPPED;
+  }
+
+  return configureEvent;
+}
+
+/// Get the position of a top-level window relative to the root from the server
+static void
+queryRootPosition(PuglView* const view)
+{
+  Display* const       display = view->world->impl->display;
+  PuglInternals* const impl    = view->impl;
+  const Window         root    = RootWindow(display, impl->screen);
+  int                  x       = 0;
+  int                  y       = 0;
+  Window               ignored = 0;
+
+  if (XTranslateCoordinates(display, impl->win, root, 0, 0, &x, &y, &ignored)) {
+    impl->configuration.x = (PuglCoord)x;
+    impl->configuration.y = (PuglCoord)y;
+  }
+}
 
-  // Get window size from attributes
-  XWindowAttributes attrs;
-  XGetWindowAttributes(display, view->impl->win, &attrs);
+static void
+translateReparentNotify(PuglView* const view, const XReparentEvent message)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
 
-  // Get window position (relative to the root window if not a child)
-  Window ignoredChild = 0;
-  int    x            = attrs.x;
-  int    y            = attrs.y;
+  impl->reparented   = message.parent != RootWindow(display, impl->screen);
+  impl->frameOffsetX = message.x;
+  impl->frameOffsetY = message.y;
   if (!view->parent) {
-    XTranslateCoordinates(
-      display, view->impl->win, attrs.root, 0, 0, &x, &y, &ignoredChild);
+    queryRootPosition(view);
   }
+}
+
+static PuglEvent
+translateConfigureNotify(PuglView* const view, const XConfigureEvent message)
+{
+  PuglInternals* const impl = view->impl;
 
-  // Build a configure event based on the current window configuration
-  PuglEvent configureEvent        = {{PUGL_CONFIGURE, 0U}};
-  configureEvent.configure.x      = (PuglCoord)x;
-  configureEvent.configure.y      = (PuglCoord)y;
-  configureEvent.configure.width  = (PuglSpan)attrs.width;
-  configureEvent.configure.height = (PuglSpan)attrs.height;
-  configureEvent.configure.style  = getCurrentViewStyleFlags(view);
+  const bool movedInFrame =
+    message.x != impl->frameOffsetX || message.y != impl->frameOffsetY;
 
-  return configureEvent;
+  impl->configuration.width  = (PuglSpan)message.width;
+  impl->configuration.height = (PuglSpan)message.height;
+
+  if (view->parent || message.send_event || !impl->reparented) {
+    /* The position is relative to the parent for embedded views, and relative
+       to the root for synthetic events (sent by the window manager) or
+       top-level windows that haven't been reparented into a frame. */
+    impl->configuration.x = (PuglCoord)message.x;
+    impl->configuration.y = (PuglCoord)message.y;
+  } else if (movedInFrame) {
+    /* A real event for a reparented window has a position relative to the
+       window manager's frame, so the root position can't be derived from the
+       event.  This is the only case that needs a round trip, and it's skipped
+       unless the window has moved within its frame, since resizes don't move
+       the window's origin in the frame, and frame moves are reported by
+       synthetic events. */
+    impl->frameOffsetX = message.x;
+    impl->frameOffsetY = message.y;
+    queryRootPosition(view);
+  }
+
+  return getCurrentConfiguration(view);
 }
 
 static PuglEvent
 translatePropertyNotify(PuglView* const view, XPropertyEvent message)
 {
-  const PuglInternals* const impl  = view->impl;
-  const PuglX11Atoms* const  atoms = &view->world->impl->atoms;
-  PuglEvent                  event = {{PUGL_NOTHING, 0U}};
+  PuglInternals* const      impl  = view->impl;
+  const PuglX11Atoms* const atoms = &view->world->impl->atoms;
+  PuglEvent                 event = {{PUGL_NOTHING, 0U}};
 
   if (message.atom == atoms->NET_WM_STATE) {
-    // Get all the current states set in the window hints
-    unsigned long numHints = 0;
-    Atom*         hints    = NULL;
-    if (getAtomProperty(view, impl->win, message.atom, &numHints, &hints)) {
+    // Update the cached style from the current states set in the window hints
+    PuglViewStyleFlags flags = 0U;
+    if (getWmStateFlags(view, &flags)) {
       return event;
     }
 
     // Make a configure event based on the current configuration to update
-    event = getCurrentConfiguration(view);
-
-    XFree(hints);
+    impl->configuration.style = flags;
+    event                     = getCurrentConfiguration(view);
   } else if (message.atom == atoms->NET_FRAME_EXTENTS) {
     Atom          actualType     = 0;
     int           actualFormat   = 0;
@@ -1339,33 +1679,21 @@ translateEvent(PuglView* const view, XEvent xevent)
     event              = getCurrentConfiguration(view);
     break;
   case UnmapNotify:
-    view->impl->mapped = false;
-    event              = getCurrentConfiguration(view);
+    view->impl->mapped         = false;
+    view->impl->presentPending = false;
+    event                      = getCurrentConfiguration(view);
     break;
   case DestroyNotify:
+    XDeleteContext(view->world->impl->display,
+                   view->impl->win,
+                   view->world->impl->viewContext);
     view->impl->win = None;
     break;
+  case ReparentNotify:
+    translateReparentNotify(view, xevent.xreparent);
+    break;
   case ConfigureNotify:
-    event                  = getCurrentConfiguration(view);
-    event.configure.width  = (PuglSpan)xevent.xconfigure.width;
-    event.configure.height = (PuglSpan)xevent.xconfigure.height;
-    if (view->parent) {
-      // Use window position relative to parent
-      event.configure.x = (PuglCoord)xevent.xconfigure.x;
-      event.configure.y = (PuglCoord)xevent.xconfigure.y;
-    } else {
-      // Get window position relative to the root
-      Display* const display = view->world->impl->display;
-      const Window   win     = view->impl->win;
-      const Window   root    = RootWindow(display, view->impl->screen);
-      int            x       = 0;
-      int            y       = 0;
-      Window         ignored = 0;
-      if (XTranslateCoordinates(display, win, root, 0, 0, &x, &y, &ignored)) {
-        event.configure.x = (PuglCoord)x;
-        event.configure.y = (PuglCoord)y;
-      }
-    }
+    event = translateConfigureNotify(view, xevent.xconfigure);
     break;
   case Expose:
     event.type          = PUGL_EXPOSE;
@@ -1374,6 +1702,14 @@ translateEvent(PuglView* const view, XEvent xevent)
     event.expose.width  = (PuglSpan)xevent.xexpose.width;
     event.expose.height = (PuglSpan)xevent.xexpose.height;
     break;
+  case GraphicsExpose:
+    // Part of a scrolled area that couldn't be copied
+    event.type          = PUGL_EXPOSE;
+    event.expose.x      = (PuglCoord)xevent.xgraphicsexpose.x;
+    event.expose.y      = (PuglCoord)xevent.xgraphicsexpose.y;
+    event.expose.width  = (PuglSpan)xevent.xgraphicsexpose.width;
+    event.expose.height = (PuglSpan)xevent.xgraphicsexpose.height;
+    break;
   case MotionNotify:
     event.type         = PUGL_MOTION;
     event.motion.time  = (double)xevent.xmotion.time / 1e3;
@@ -1515,75 +1851,75 @@ puglHasFocus(const PuglView* const view)
 PuglStatus
 puglStartTimer(PuglView* const view, const uintptr_t id, const double timeout)
 {
-#if USE_XSYNC
-  if (view->world->impl->syncSupported) {
-    XSyncValue value;
-    XSyncIntToValue(&value, (int)(timeout * 1000.0));
-
-    PuglWorldInternals*  w       = view->world->impl;
-    Display* const       display = w->display;
-    const XSyncCounter   counter = w->serverTimeCounter;
-    const XSyncTestType  type    = XSyncPositiveTransition;
-    const XSyncTrigger   trigger = {counter, XSyncRelative, value, type};
-    XSyncAlarmAttributes attr    = {trigger, value, True, XSyncAlarmActive};
-    const XSyncAlarm     alarm   = XSyncCreateAlarm(display, 0x17, &attr);
-    const PuglTimer      timer   = {alarm, view, id};
-
-    if (alarm != None) {
-      for (size_t i = 0; i < w->numTimers; ++i) {
-        if (w->timers[i].view == view && w->timers[i].id == id) {
-          // Replace existing timer
-          XSyncDestroyAlarm(w->display, w->timers[i].alarm);
-          w->timers[i] = timer;
-          return PUGL_SUCCESS;
-        }
-      }
+  PuglWorldInternals* const w        = view->world->impl;
+  PuglInternals* const      impl     = view->impl;
+  const double              period   = MAX(0.0, timeout);
+  const double              deadline = puglGetTime(view->world) + period;
+
+  if (impl->numTimers) {
+    const size_t i = findTimer(impl, id);
+    if (impl->timers[i]) {
+      // Replace existing timer
+      PuglTimer* const timer = impl->timers[i];
+      timer->period          = period;
+      timer->deadline        = deadline;
+      fixTimer(w, timer->index);
+      return PUGL_SUCCESS;
+    }
+  }
 
-      // Add new timer
-      const size_t     size      = ++w->numTimers * sizeof(timer);
-      PuglTimer* const newTimers = (PuglTimer*)realloc(w->timers, size);
-      if (newTimers) {
-        w->timers                   = newTimers;
-        w->timers[w->numTimers - 1] = timer;
-        return PUGL_SUCCESS;
-      }
+  // Enlarge the world timer heap if necessary (amortized by doubling)
+  if (w->numTimers == w->maxTimers) {
+    const size_t      newMaxTimers = w->maxTimers ? w->maxTimers * 2U : 16U;
+    PuglTimer** const timers =
+      (PuglTimer**)realloc(w->timers, newMaxTimers * sizeof(PuglTimer*));
+
+    if (!timers) {
+      return PUGL_NO_MEMORY;
     }
+
+    w->timers    = timers;
+    w->maxTimers = newMaxTimers;
   }
-#else
-  (void)view;
-  (void)id;
-  (void)timeout;
-#endif
 
-  return PUGL_FAILURE;
+  // Enlarge the view timer table if necessary (also amortized by doubling)
+  const PuglStatus st = reserveTimer(impl);
+  if (st) {
+    return st;
+  }
+
+  // Allocate a new timer
+  PuglTimer* const timer = (PuglTimer*)calloc(1, sizeof(PuglTimer));
+  if (!timer) {
+    return PUGL_NO_MEMORY;
+  }
+
+  timer->view     = view;
+  timer->id       = id;
+  timer->period   = period;
+  timer->deadline = deadline;
+
+  // Add to the view table and the world heap
+  impl->timers[findTimer(impl, id)] = timer;
+  ++impl->numTimers;
+  setHeapTimer(w, w->numTimers++, timer);
+  siftTimerUp(w, timer->index);
+  return PUGL_SUCCESS;
 }
 
 PuglStatus
 puglStopTimer(PuglView* const view, const uintptr_t id)
 {
-#if USE_XSYNC
-  PuglWorldInternals* w = view->world->impl;
-
-  for (size_t i = 0; i < w->numTimers; ++i) {
-    if (w->timers[i].view == view && w->timers[i].id == id) {
-      XSyncDestroyAlarm(w->display, w->timers[i].alarm);
-
-      if (i != w->numTimers - 1) {
-        memmove(w->timers + i,
-                w->timers + i + 1,
-                sizeof(PuglTimer) * (w->numTimers - i - 1));
-      }
-
-      memset(&w->timers[w->numTimers - 1], 0, sizeof(PuglTimer));
+  PuglInternals* const impl = view->impl;
+  if (!impl->numTimers) {
+    return PUGL_FAILURE;
+  }
 
-      --w->numTimers;
-      return PUGL_SUCCESS;
-    }
+  const size_t i = findTimer(impl, id);
+  if (impl->timers[i]) {
+    removeTimer(view, i);
+    return PUGL_SUCCESS;
   }
-#else
-  (void)view;
-  (void)id;
-#endif
 
   return PUGL_FAILURE;
 }
@@ -1681,26 +2017,107 @@ mergeExposeEvents(PuglExposeEvent* const dst, const PuglExposeEvent* const src)
   }
 }
 
-static PuglStatus
-retrieveSelection(const PuglWorld* const world,
-                  PuglView* const        view,
-                  const Atom             property,
-                  const Atom             type,
-                  PuglBlob* const        result)
+static uint32_t
+rectArea(const PuglRect rect)
 {
-  uint8_t*      value          = NULL;
-  Atom          actualType     = 0U;
-  int           actualFormat   = 0;
-  unsigned long actualNumItems = 0U;
-  unsigned long bytesAfter     = 0U;
+  return (uint32_t)rect.width * rect.height;
+}
 
-  if (XGetWindowProperty(world->impl->display,
-                         view->impl->win,
-                         property,
-                         0,
-                         0x1FFFFFFF,
-                         False,
-                         type,
+static bool
+rectContains(const PuglRect outer, const PuglRect inner)
+{
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.width <= outer.x + outer.width &&
+         inner.y + inner.height <= outer.y + outer.height;
+}
+
+static PuglRect
+rectUnion(const PuglRect a, const PuglRect b)
+{
+  const PuglCoord x      = MIN(a.x, b.x);
+  const PuglCoord y      = MIN(a.y, b.y);
+  const int       right  = MAX(a.x + a.width, b.x + b.width);
+  const int       bottom = MAX(a.y + a.height, b.y + b.height);
+
+  const PuglRect result = {
+    x, y, (PuglSpan)(right - x), (PuglSpan)(bottom - y)};
+
+  return result;
+}
+
+/// Add an exposed area to the pending expose and damage region of a view
+static void
+addDamage(PuglView* const view, const PuglExposeEvent* const expose)
+{
+  PuglInternals* const impl = view->impl;
+  const PuglRect rect = {expose->x, expose->y, expose->width, expose->height};
+  if (!rect.width || !rect.height) {
+    return;
+  }
+
+  // Expand the bounding box of the expose event
+  mergeExposeEvents(&impl->pendingExpose.expose, expose);
+
+  // Ignore the new rectangle if it's already covered
+  for (size_t i = 0U; i < impl->numDamageRects; ++i) {
+    if (rectContains(impl->damage[i], rect)) {
+      return;
+    }
+  }
+
+  // Remove any existing rectangles that the new one covers
+  for (size_t i = 0U; i < impl->numDamageRects;) {
+    if (rectContains(rect, impl->damage[i])) {
+      impl->damage[i] = impl->damage[--impl->numDamageRects];
+    } else {
+      ++i;
+    }
+  }
+
+  // Find the rectangle that would waste the least area if merged
+  size_t  best     = 0U;
+  int64_t bestCost = INT64_MAX;
+  for (size_t i = 0U; i < impl->numDamageRects; ++i) {
+    const PuglRect merged = rectUnion(impl->damage[i], rect);
+    const int64_t  cost   = (int64_t)rectArea(merged) -
+                         (int64_t)rectArea(impl->damage[i]) -
+                         (int64_t)rectArea(rect);
+    if (cost < bestCost) {
+      best     = i;
+      bestCost = cost;
+    }
+  }
+
+  /* Merge with that rectangle if doing so costs nothing (the rectangles
+     overlap at least as much as the merge adds) or the region is full,
+     otherwise add a separate rectangle. */
+  if (bestCost <= 0 || impl->numDamageRects == PUGL_MAX_DAMAGE_RECTS) {
+    impl->damage[best] = rectUnion(impl->damage[best], rect);
+  } else {
+    impl->damage[impl->numDamageRects++] = rect;
+  }
+}
+
+static PuglStatus
+retrieveSelection(const PuglWorld* const world,
+                  PuglView* const        view,
+                  const Atom             property,
+                  const Atom             type,
+                  PuglBlob* const        result)
+{
+  uint8_t*      value          = NULL;
+  Atom          actualType     = 0U;
+  int           actualFormat   = 0;
+  unsigned long actualNumItems = 0U;
+  unsigned long bytesAfter     = 0U;
+
+  if (XGetWindowProperty(world->impl->display,
+                         view->impl->win,
+                         property,
+                         0,
+                         0x1FFFFFFF,
+                         False,
+                         type,
                          &actualType,
                          &actualFormat,
                          &actualNumItems,
@@ -1865,6 +2282,17 @@ flushExposures(PuglWorld* const world)
   PuglStatus st0 = PUGL_SUCCESS;
   PuglStatus st1 = PUGL_SUCCESS;
 
+  // Send any coalesced configure events so views are up to date
+  for (size_t i = 0; i < world->numViews; ++i) {
+    PuglView* const view = world->views[i];
+    if (view->impl->pendingConfigure.type) {
+      const PuglEvent configure = view->impl->pendingConfigure;
+
+      view->impl->pendingConfigure.type = PUGL_NOTHING;
+      puglDispatchEvent(view, &configure);
+    }
+  }
+
   // Send update events so the application can trigger redraws
   for (size_t i = 0; i < world->numViews; ++i) {
     if (puglGetVisible(world->views[i])) {
@@ -1877,45 +2305,142 @@ flushExposures(PuglWorld* const world)
   for (size_t i = 0; i < world->numViews; ++i) {
     PuglView* const view = world->views[i];
 
-    if (puglGetVisible(view)) {
-      const PuglEvent expose = view->impl->pendingExpose;
+    // Skip views with a presented frame that hasn't been shown yet
+    if (puglGetVisible(view) && !view->impl->presentPending) {
+      PuglInternals* const impl   = view->impl;
+      const PuglEvent      expose = impl->pendingExpose;
+
+      view->exposeRects    = impl->damage;
+      view->numExposeRects = impl->numDamageRects;
       if (expose.type && !(st0 = view->backend->enter(view, &expose.expose))) {
         st0 = view->eventFunc(view, &expose);
         st1 = view->backend->leave(view, &expose.expose);
-        view->impl->pendingExpose.type = PUGL_NOTHING;
+        impl->pendingExpose.type = PUGL_NOTHING;
+        impl->numDamageRects     = 0U;
       }
+
+      view->exposeRects    = NULL;
+      view->numExposeRects = 0U;
     }
   }
 
+  // Swap the buffers of any views that deferred it until all were drawn
+  if (world->impl->swapGlViews) {
+    world->impl->swapGlViews(world);
+  }
+
   return st0 ? st0 : st1;
 }
 
-static bool
-handleTimerEvent(PuglWorld* const world, const XEvent xevent)
-{
-#if USE_XSYNC
-  if (xevent.type == world->impl->syncEventBase + XSyncAlarmNotify) {
-    const XSyncAlarmNotifyEvent* const notify =
-      ((const XSyncAlarmNotifyEvent*)&xevent);
-
-    for (size_t i = 0; i < world->impl->numTimers; ++i) {
-      if (world->impl->timers[i].alarm == notify->alarm) {
-        PuglEvent event = {{PUGL_TIMER, 0U}};
-        event.timer.id  = world->impl->timers[i].id;
-        puglDispatchEvent(world->impl->timers[i].view, &event);
+/// Dispatch any pending merged motion or scroll event for a view
+static PuglStatus
+flushPointerEvent(PuglView* const view)
+{
+  PuglStatus st = PUGL_SUCCESS;
+  if (view->impl->pendingPointer.type) {
+    const PuglEvent event = view->impl->pendingPointer;
+
+    view->impl->pendingPointer.type = PUGL_NOTHING;
+    st                              = puglDispatchEvent(view, &event);
+    view->numMotions                = 0U;
+  }
+
+  return st;
+}
+
+/// Merge a motion or scroll event into the pending pointer event for a view
+static PuglStatus
+coalescePointerEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglEvent* const pending = &view->impl->pendingPointer;
+  PuglStatus       st      = PUGL_SUCCESS;
+
+  if (event->type == PUGL_MOTION) {
+    // Replace any pending motion, and record the event in the history
+    if (pending->type != PUGL_MOTION) {
+      st = flushPointerEvent(view);
+    }
+
+    const PuglStatus st1 = puglAppendMotionHistory(view, &event->motion);
+    *pending             = *event;
+    st                   = st ? st : st1;
+  } else if (pending->type == PUGL_SCROLL &&
+             pending->scroll.direction == event->scroll.direction &&
+             pending->scroll.state == event->scroll.state) {
+    // Replace the pending scroll, but accumulate the scroll distance
+    const double dx = pending->scroll.dx + event->scroll.dx;
+    const double dy = pending->scroll.dy + event->scroll.dy;
+
+    *pending           = *event;
+    pending->scroll.dx = dx;
+    pending->scroll.dy = dy;
+  } else {
+    st       = flushPointerEvent(view);
+    *pending = *event;
+  }
+
+  return st;
+}
+
+#if USE_XPRESENT
+
+/// Handle a Present extension event by dispatching a present event
+static PuglStatus
+handlePresentEvent(PuglWorld* const world, XGenericEventCookie* const cookie)
+{
+  Display* const display = world->impl->display;
+  PuglView*      view    = NULL;
+  PuglEvent      event   = {{PUGL_NOTHING, 0U}};
+
+  if (!XGetEventData(display, cookie)) {
+    return PUGL_SUCCESS;
+  }
+
+  if (cookie->evtype == PresentCompleteNotify) {
+    const XPresentCompleteNotifyEvent* const complete =
+      (const XPresentCompleteNotifyEvent*)cookie->data;
+
+    // Allow the view to be exposed again once the latest frame is shown
+    if (complete->kind == PresentCompleteKindPixmap &&
+        (view = findView(world, complete->window))) {
+      if (complete->serial_number == view->impl->presentSerial) {
+        view->impl->presentPending = false;
       }
+
+      // The server's UST is in microseconds on the monotonic clock
+      event.present.type   = PUGL_PRESENT;
+      event.present.kind   = PUGL_PRESENT_COMPLETE;
+      event.present.serial = complete->serial_number;
+      event.present.msc    = complete->msc;
+      event.present.time   = ((double)complete->ust / 1e6) - world->startTime;
     }
 
-    return true;
+  } else if (cookie->evtype == PresentIdleNotify) {
+    const XPresentIdleNotifyEvent* const idle =
+      (const XPresentIdleNotifyEvent*)cookie->data;
+
+    // Remove the pixmap from the busy set so it can be drawn to again
+    if ((view = findView(world, idle->window))) {
+      PuglInternals* const impl = view->impl;
+      for (size_t i = 0U; i < impl->numBusyPixmaps; ++i) {
+        if (impl->busyPixmaps[i] == idle->pixmap) {
+          impl->busyPixmaps[i] = impl->busyPixmaps[--impl->numBusyPixmaps];
+          break;
+        }
+      }
+
+      event.present.type   = PUGL_PRESENT;
+      event.present.kind   = PUGL_PRESENT_IDLE;
+      event.present.serial = idle->serial_number;
+    }
   }
-#else
-  (void)world;
-  (void)xevent;
-#endif
 
-  return false;
+  XFreeEventData(display, cookie);
+  return event.type ? puglDispatchEvent(view, &event) : PUGL_SUCCESS;
 }
 
+#endif
+
 static PuglStatus
 dispatchX11Events(PuglWorld* const world)
 {
@@ -1930,9 +2455,16 @@ dispatchX11Events(PuglWorld* const world)
     XEvent xevent;
     XNextEvent(display, &xevent);
 
-    if (handleTimerEvent(world, xevent)) {
+#if USE_XPRESENT
+    // Handle Present events, which have no window in the common header
+    if (xevent.type == GenericEvent &&
+        xevent.xcookie.extension == world->impl->presentOpcode) {
+      if ((st = handlePresentEvent(world, &xevent.xcookie))) {
+        break;
+      }
       continue;
     }
+#endif
 
     PuglView* const view = findView(world, xevent.xany.window);
     if (!view) {
@@ -1967,10 +2499,32 @@ dispatchX11Events(PuglWorld* const world)
     // Translate X11 event to Pugl event
     const PuglEvent event = translateEvent(view, xevent);
 
+    // Dispatch any merged pointer event first to preserve the event order
+    if (event.type && event.type != PUGL_MOTION && event.type != PUGL_SCROLL) {
+      st = flushPointerEvent(view);
+    }
+
     switch (event.type) {
     case PUGL_EXPOSE:
       // Expand expose event to be dispatched after loop
-      mergeExposeEvents(&view->impl->pendingExpose.expose, &event.expose);
+      addDamage(view, &event.expose);
+      break;
+    case PUGL_CONFIGURE:
+      if (view->hints[PUGL_COALESCE_CONFIGURE] == PUGL_TRUE) {
+        // Replace configure event to be dispatched after loop
+        view->impl->pendingConfigure = event;
+      } else {
+        st = puglDispatchEvent(view, &event);
+      }
+      break;
+    case PUGL_MOTION:
+    case PUGL_SCROLL:
+      if (view->hints[PUGL_COALESCE_POINTER] == PUGL_TRUE) {
+        // Merge into the pending pointer event to be dispatched later
+        st = coalescePointerEvent(view, &event);
+      } else {
+        st = puglDispatchEvent(view, &event);
+      }
       break;
     case PUGL_FOCUS_IN:
       // Set the input context focus
@@ -1991,12 +2545,357 @@ dispatchX11Events(PuglWorld* const world)
     }
   }
 
+  // Dispatch the merged pointer events for this pass
+  for (size_t i = 0; i < world->numViews; ++i) {
+    const PuglStatus st1 = flushPointerEvent(world->views[i]);
+    st                   = st ? st : st1;
+  }
+
   // Flush any events we may have sent in this frame to reduce latency
   XFlush(display);
 
   return st;
 }
 
+/// Return the next time to poll for presented frames, or -1 if there are none
+static double
+getNextPresentPoll(const PuglWorld* const world, const double now)
+{
+  double next = -1.0;
+
+  for (size_t i = 0U; i < world->numViews; ++i) {
+    const PuglInternals* const impl = world->views[i]->impl;
+    if (impl->pollPresents && impl->numPendingPresents) {
+      // Poll when the next frame should be shown, or soon if that's unknown
+      const double t = (impl->nextPresentTime > now)
+                         ? impl->nextPresentTime
+                         : now + PUGL_PRESENT_POLL_PERIOD;
+
+      next = (next < 0.0) ? t : MIN(next, t);
+    }
+  }
+
+  return next;
+}
+
+/// Return the time to wait for events, limited by the next timer deadline
+static double
+getWaitTimeout(const PuglWorld* const world,
+               const double           now,
+               const double           timeout)
+{
+  const PuglWorldInternals* const w    = world->impl;
+  const double                    poll = getNextPresentPoll(world, now);
+  double                          wait = timeout;
+
+  // Wake up to poll for presented frames being shown if necessary
+  if (poll >= 0.0) {
+    const double untilPoll = MAX(0.0, poll - now);
+    wait = (wait < 0.0) ? untilPoll : MIN(wait, untilPoll);
+  }
+
+  if (!w->numTimers) {
+    return wait;
+  }
+
+  const double untilNext = MAX(0.0, w->timers[0]->deadline - now);
+  return (wait < 0.0) ? untilNext : MIN(wait, untilNext);
+}
+
+/// Dispatch timer events for all timers that have expired
+static PuglStatus
+dispatchTimers(PuglWorld* const world)
+{
+  PuglWorldInternals* const w   = world->impl;
+  const double              now = puglGetTime(world);
+  PuglStatus                st  = PUGL_SUCCESS;
+
+  // Fire each expired timer at most once, since handlers may restart timers
+  for (size_t n = w->numTimers;
+       n && w->numTimers && w->timers[0]->deadline <= now;
+       --n) {
+    PuglTimer* const timer = w->timers[0];
+    PuglView* const  view  = timer->view;
+    PuglEvent        event = {{PUGL_TIMER, 0U}};
+    event.timer.id         = timer->id;
+
+    // Schedule the next expiry, skipping any missed ones
+    timer->deadline += timer->period;
+    if (timer->deadline <= now) {
+      timer->deadline = now + timer->period;
+    }
+
+    siftTimerDown(w, 0U);
+
+    const PuglStatus st1 = puglDispatchEvent(view, &event);
+    st                   = st ? st : st1;
+  }
+
+  return st;
+}
+
+/// Return true if there are events posted from other threads to dispatch
+static bool
+hasPostedEvents(const PuglWorldInternals* const w)
+{
+  const size_t                 pos  = w->postHead;
+  const PuglPostedEvent* const cell =
+    &w->posted[pos & (PUGL_NUM_POSTED_EVENTS - 1U)];
+
+  return __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) == pos + 1U;
+}
+
+/// Dispatch client events posted from other threads
+static PuglStatus
+dispatchPostedEvents(PuglWorld* const world)
+{
+  PuglWorldInternals* const w    = world->impl;
+  struct pollfd* const      wake = &w->pollFds[POLL_WAKE_FD];
+  PuglStatus                st   = PUGL_SUCCESS;
+
+  /* Drain the wake file descriptor, then clear the wake flag, before reading
+     the queue.  A producer that saw the flag set published its event before
+     it was cleared, so the event is found below, and any producer after that
+     writes to the file descriptor again, so no wakeup can be lost. */
+  if (__atomic_load_n(&w->wakePending, __ATOMIC_ACQUIRE) ||
+      (wake->revents & POLLIN)) {
+    uint64_t value = 0U;
+    while (read(w->wakeFds[0], &value, sizeof(value)) > 0) {
+    }
+
+    (void)__atomic_exchange_n(&w->wakePending, false, __ATOMIC_ACQ_REL);
+  }
+
+  wake->revents = 0;
+
+  // Dispatch at most a full queue so busy producers can't stall the loop
+  for (size_t n = 0U; n < PUGL_NUM_POSTED_EVENTS && hasPostedEvents(w); ++n) {
+    const size_t           pos  = w->postHead;
+    PuglPostedEvent* const cell =
+      &w->posted[pos & (PUGL_NUM_POSTED_EVENTS - 1U)];
+
+    PuglView* const view  = cell->view;
+    PuglEvent       event = {{PUGL_CLIENT, 0U}};
+    event.client.data1    = cell->data1;
+    event.client.data2    = cell->data2;
+
+    // Release the cell for reuse by producers on the next lap
+    __atomic_store_n(
+      &cell->sequence, pos + PUGL_NUM_POSTED_EVENTS, __ATOMIC_RELEASE);
+    w->postHead = pos + 1U;
+
+    if (view) {
+      const PuglStatus st1 = puglDispatchEvent(view, &event);
+      st                   = st ? st : st1;
+    }
+  }
+
+  // Wake up again to dispatch the rest if the loop stopped with a full queue
+  if (hasPostedEvents(w) &&
+      !__atomic_exchange_n(&w->wakePending, true, __ATOMIC_ACQ_REL)) {
+    const uint64_t value = 1U;
+    if (write(w->wakeFds[1], &value, sizeof(value)) < 0 && errno != EAGAIN) {
+      st = st ? st : PUGL_UNKNOWN_ERROR;
+    }
+  }
+
+  return st;
+}
+
+/// Call the functions for any watched file descriptors that are ready
+static PuglStatus
+dispatchWatches(PuglWorld* const world)
+{
+  PuglWorldInternals* const w  = world->impl;
+  PuglStatus                st = PUGL_SUCCESS;
+
+  /* Iterate backwards so that callbacks can safely add watches (which are
+     appended) or remove them (which moves only those after the removed one,
+     all of which have already been handled and had their results cleared). */
+  for (size_t i = w->numWatches; i-- > 0U;) {
+    if (i >= w->numWatches) {
+      continue;
+    }
+
+    struct pollfd* const pfd     = &w->pollFds[NUM_INTERNAL_POLL_FDS + i];
+    const int            fd      = pfd->fd;
+    const short          revents = pfd->revents;
+    const PuglWatch      watch   = w->watches[i];
+
+    pfd->revents = 0;
+
+    // Report errors and hangups as all watched conditions so they're handled
+    const PuglWatchFlags ready =
+      (revents & (POLLERR | POLLHUP | POLLNVAL))
+        ? watch.flags
+        : (watch.flags &
+           (((revents & POLLIN) ? (PuglWatchFlags)PUGL_WATCH_READ : 0U) |
+            ((revents & POLLOUT) ? (PuglWatchFlags)PUGL_WATCH_WRITE : 0U)));
+
+    if (ready) {
+      const PuglStatus st1 = watch.func(world, fd, ready, watch.data);
+      st                   = st ? st : st1;
+    }
+  }
+
+  return st;
+}
+
+/// Dispatch present events for frames that backends have seen being shown
+static PuglStatus
+dispatchPresents(PuglWorld* const world)
+{
+  PuglStatus st = PUGL_SUCCESS;
+
+  for (size_t i = 0U; !st && i < world->numViews; ++i) {
+    PuglView* const view = world->views[i];
+    if (view->impl->pollPresents && view->impl->numPendingPresents) {
+      st = view->impl->pollPresents(view);
+    }
+  }
+
+  return st;
+}
+
+/// Dispatch all pending window system events, file events, and timers
+static PuglStatus
+dispatchAllEvents(PuglWorld* const world)
+{
+  PuglStatus st = dispatchX11Events(world);
+
+  st = st ? st : dispatchPostedEvents(world);
+  st = st ? st : dispatchWatches(world);
+  st = st ? st : dispatchTimers(world);
+  return st ? st : dispatchPresents(world);
+}
+
+PuglStatus
+puglWatchFd(PuglWorld* const     world,
+            const int            fd,
+            const PuglWatchFlags flags,
+            const PuglWatchFunc  func,
+            void* const          data)
+{
+  PuglWorldInternals* const w = world->impl;
+  if (fd < 0 || !flags || !func) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  const short events = (short)(((flags & PUGL_WATCH_READ) ? POLLIN : 0) |
+                               ((flags & PUGL_WATCH_WRITE) ? POLLOUT : 0));
+
+  const PuglWatch watch = {func, data, flags};
+
+  // Replace an existing watch for this file descriptor
+  for (size_t i = 0U; i < w->numWatches; ++i) {
+    struct pollfd* const pfd = &w->pollFds[NUM_INTERNAL_POLL_FDS + i];
+    if (pfd->fd == fd) {
+      pfd->events   = events;
+      w->watches[i] = watch;
+      return PUGL_SUCCESS;
+    }
+  }
+
+  // Enlarge the poll descriptor array (which starts with internal ones)
+  struct pollfd* const pollFds = (struct pollfd*)realloc(
+    w->pollFds,
+    (NUM_INTERNAL_POLL_FDS + w->numWatches + 1U) * sizeof(struct pollfd));
+  if (!pollFds) {
+    return PUGL_NO_MEMORY;
+  }
+
+  w->pollFds = pollFds;
+
+  // Enlarge the watch array
+  PuglWatch* const watches =
+    (PuglWatch*)realloc(w->watches, (w->numWatches + 1U) * sizeof(PuglWatch));
+  if (!watches) {
+    return PUGL_NO_MEMORY;
+  }
+
+  const struct pollfd pfd = {fd, events, 0};
+
+  w->watches                                        = watches;
+  w->watches[w->numWatches]                         = watch;
+  w->pollFds[NUM_INTERNAL_POLL_FDS + w->numWatches] = pfd;
+  ++w->numWatches;
+  return PUGL_SUCCESS;
+}
+
+PuglStatus
+puglUnwatchFd(PuglWorld* const world, const int fd)
+{
+  PuglWorldInternals* const w = world->impl;
+
+  for (size_t i = 0U; i < w->numWatches; ++i) {
+    if (w->pollFds[NUM_INTERNAL_POLL_FDS + i].fd == fd) {
+      const size_t numAfter = w->numWatches - i - 1U;
+
+      memmove(
+        w->watches + i, w->watches + i + 1U, numAfter * sizeof(PuglWatch));
+      memmove(w->pollFds + NUM_INTERNAL_POLL_FDS + i,
+              w->pollFds + NUM_INTERNAL_POLL_FDS + i + 1U,
+              numAfter * sizeof(struct pollfd));
+
+      --w->numWatches;
+      return PUGL_SUCCESS;
+    }
+  }
+
+  return PUGL_FAILURE;
+}
+
+PuglStatus
+puglPostClientEvent(PuglView* const view,
+                    const uintptr_t data1,
+                    const uintptr_t data2)
+{
+  PuglWorldInternals* const w    = view->world->impl;
+  PuglPostedEvent*          cell = NULL;
+
+  size_t pos = __atomic_load_n(&w->postTail, __ATOMIC_RELAXED);
+
+  /* Claim a cell by advancing the tail, as in Vyukov's bounded queue.  Each
+     cell's sequence is its position when free, one more when it holds an
+     event, and its position on the next lap when it has been dispatched. */
+  for (;;) {
+    cell = &w->posted[pos & (PUGL_NUM_POSTED_EVENTS - 1U)];
+
+    const size_t   seq  = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    const intptr_t diff = (intptr_t)(seq - pos);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&w->postTail,
+                                      &pos,
+                                      pos + 1U,
+                                      true,
+                                      __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return PUGL_FAILURE; // Queue is full
+    } else {
+      pos = __atomic_load_n(&w->postTail, __ATOMIC_RELAXED);
+    }
+  }
+
+  // Fill in the event and publish it to the consumer
+  cell->view  = view;
+  cell->data1 = data1;
+  cell->data2 = data2;
+  __atomic_store_n(&cell->sequence, pos + 1U, __ATOMIC_RELEASE);
+
+  // Wake up the event loop, unless a previous post already did
+  if (!__atomic_exchange_n(&w->wakePending, true, __ATOMIC_ACQ_REL)) {
+    const uint64_t value = 1U;
+    if (write(w->wakeFds[1], &value, sizeof(value)) < 0 && errno != EAGAIN) {
+      return PUGL_UNKNOWN_ERROR;
+    }
+  }
+
+  return PUGL_SUCCESS;
+}
+
 PuglStatus
 puglUpdate(PuglWorld* const world, const double timeout)
 {
@@ -2012,17 +2911,22 @@ puglUpdate(PuglWorld* const world, const double timeout)
   }
 
   if (timeout < 0.0) {
-    if (!(st0 = pollX11Socket(world, timeout))) {
-      st0 = dispatchX11Events(world);
+    const double wait = getWaitTimeout(world, startTime, timeout);
+    if (!(st0 = pollX11Socket(world, wait))) {
+      st0 = dispatchAllEvents(world);
     }
   } else if (timeout <= 0.001) {
-    st0 = dispatchX11Events(world);
+    // Only poll (without waiting) if there are watched file descriptors
+    if (!world->impl->numWatches || !(st0 = pollX11Socket(world, 0.0))) {
+      st0 = dispatchAllEvents(world);
+    }
   } else {
     const double endTime = startTime + timeout - 0.001;
     double       t       = startTime;
     while (!st0 && t < endTime) {
-      if (!(st0 = pollX11Socket(world, endTime - t))) {
-        st0 = dispatchX11Events(world);
+      const double wait = getWaitTimeout(world, t, endTime - t);
+      if (!(st0 = pollX11Socket(world, wait))) {
+        st0 = dispatchAllEvents(world);
       }
 
       t = puglGetTime(world);
@@ -2034,6 +2938,98 @@ puglUpdate(PuglWorld* const world, const double timeout)
   return st0 ? st0 : st1;
 }
 
+/// Return true if any view has a coalesced configure or exposure to flush
+static bool
+hasPendingViewEvents(const PuglWorld* const world)
+{
+  for (size_t i = 0U; i < world->numViews; ++i) {
+    const PuglView* const      view = world->views[i];
+    const PuglInternals* const impl = view->impl;
+
+    if (impl->pendingConfigure.type ||
+        (impl->pendingExpose.type && puglGetVisible(view) &&
+         !impl->presentPending)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int
+puglGetWorldFd(const PuglWorld* const world)
+{
+  return ConnectionNumber(world->impl->display);
+}
+
+int
+puglGetWakeFd(const PuglWorld* const world)
+{
+  return world->impl->wakeFds[0];
+}
+
+double
+puglGetNextDeadline(const PuglWorld* const world)
+{
+  const PuglWorldInternals* const w = world->impl;
+
+  if (XEventsQueued(w->display, QueuedAlready) > 0 || hasPostedEvents(w) ||
+      hasPendingViewEvents(world)) {
+    return puglGetTime(world);
+  }
+
+  // Poll for presented frames being shown if necessary
+  const double poll = getNextPresentPoll(world, puglGetTime(world));
+  if (poll >= 0.0) {
+    return w->numTimers ? MIN(poll, w->timers[0]->deadline) : poll;
+  }
+
+  return w->numTimers ? w->timers[0]->deadline : -1.0;
+}
+
+PuglStatus
+puglPrepareUpdate(PuglWorld* const world, double* const timeout)
+{
+  // Flush first, since doing so may read events into the queue
+  XFlush(world->impl->display);
+
+  const double deadline = puglGetNextDeadline(world);
+
+  *timeout = (deadline < 0.0) ? -1.0 : MAX(0.0, deadline - puglGetTime(world));
+  return PUGL_SUCCESS;
+}
+
+bool
+puglCheckUpdate(PuglWorld* const world)
+{
+  PuglWorldInternals* const w = world->impl;
+
+  // Read any available events from the connection without blocking
+  if (XEventsQueued(w->display, QueuedAfterReading) > 0) {
+    return true;
+  }
+
+  // Check if the wake file descriptor is readable, so it's reset on dispatch
+  if (poll(&w->pollFds[POLL_WAKE_FD], 1, 0) > 0) {
+    return true;
+  }
+
+  // Check if any watched file descriptors are ready
+  struct pollfd* const watchFds = w->pollFds + NUM_INTERNAL_POLL_FDS;
+  if (w->numWatches && poll(watchFds, (nfds_t)w->numWatches, 0) > 0) {
+    return true;
+  }
+
+  const double deadline = puglGetNextDeadline(world);
+  return deadline >= 0.0 && deadline <= puglGetTime(world);
+}
+
+PuglStatus
+puglDispatchUpdate(PuglWorld* const world)
+{
+  return puglUpdate(world, 0.0);
+}
+
 double
 puglGetTime(const PuglWorld* const world)
 {
@@ -2074,7 +3070,7 @@ puglObscureRegion(PuglView* const view,
   PuglStatus st = PUGL_SUCCESS;
   if (view->world->state == PUGL_WORLD_UPDATING) {
     // Currently dispatching events, add/expand expose for the loop end
-    mergeExposeEvents(&view->impl->pendingExpose.expose, &event);
+    addDamage(view, &event);
   } else if (view->world->state == PUGL_WORLD_EXPOSING) {
     st = PUGL_BAD_CALL;
   } else if (view->impl->win) {
@@ -2086,6 +3082,90 @@ puglObscureRegion(PuglView* const view,
   return st;
 }
 
+PuglStatus
+puglScrollRegion(PuglView* const view,
+                 const int       x,
+                 const int       y,
+                 const unsigned  width,
+                 const unsigned  height,
+                 const int       dx,
+                 const int       dy)
+{
+  PuglInternals* const impl = view->impl;
+
+  if (!puglIsValidPosition(x, y) || !puglIsValidSize(width, height) ||
+      !puglIsValidPosition(dx, dy)) {
+    return PUGL_BAD_PARAMETER;
+  }
+
+  if (view->world->state == PUGL_WORLD_EXPOSING) {
+    return PUGL_BAD_CALL;
+  }
+
+  // Clip the rectangle to the view
+  const PuglSpan  viewWidth  = view->lastConfigure.width;
+  const PuglSpan  viewHeight = view->lastConfigure.height;
+  const PuglCoord cx         = MAX((PuglCoord)0, (PuglCoord)x);
+  const PuglCoord cy         = MAX((PuglCoord)0, (PuglCoord)y);
+  const int       right      = MIN(x + (int)width, (int)viewWidth);
+  const int       bottom     = MIN(y + (int)height, (int)viewHeight);
+  if (right <= cx || bottom <= cy || (!dx && !dy)) {
+    return PUGL_SUCCESS;
+  }
+
+  const PuglSpan cw   = (PuglSpan)(right - cx);
+  const PuglSpan ch   = (PuglSpan)(bottom - cy);
+  const PuglRect rect = {cx, cy, cw, ch};
+  const unsigned adx  = (unsigned)abs(dx);
+  const unsigned ady  = (unsigned)abs(dy);
+
+  /* Obscure the whole rectangle if nothing would be left, a presented frame
+     that would land on top of the moved contents hasn't been shown yet, or
+     scrolling fails. */
+  if (!impl->win || adx >= rect.width || ady >= rect.height ||
+      impl->presentPending || view->backend->scroll(view, rect, dx, dy)) {
+    return puglObscureRegion(view, cx, cy, cw, ch);
+  }
+
+  if (view->world->state == PUGL_WORLD_UPDATING) {
+    // Move any damage that hasn't been drawn yet along with the contents
+    const size_t numDamageRects = impl->numDamageRects;
+    PuglRect     damage[PUGL_MAX_DAMAGE_RECTS];
+    memcpy(damage, impl->damage, numDamageRects * sizeof(PuglRect));
+    for (size_t i = 0U; i < numDamageRects; ++i) {
+      const int l = MAX(damage[i].x + dx, cx);
+      const int t = MAX(damage[i].y + dy, cy);
+      const int r = MIN(damage[i].x + dx + damage[i].width, right);
+      const int b = MIN(damage[i].y + dy + damage[i].height, bottom);
+      if (l < r && t < b) {
+        const PuglExposeEvent moved = {PUGL_EXPOSE,
+                                       0U,
+                                       (PuglCoord)l,
+                                       (PuglCoord)t,
+                                       (PuglSpan)(r - l),
+                                       (PuglSpan)(b - t)};
+
+        addDamage(view, &moved);
+      }
+    }
+  }
+
+  // Obscure the revealed horizontal strip, then the revealed vertical strip
+  PuglStatus st = PUGL_SUCCESS;
+  if (ady) {
+    const int stripY = dy > 0 ? cy : bottom - (int)ady;
+    st               = puglObscureRegion(view, cx, stripY, cw, ady);
+  }
+
+  if (adx && !st) {
+    const int stripX = dx > 0 ? cx : right - (int)adx;
+    const int stripY = cy + MAX(dy, 0);
+    st               = puglObscureRegion(view, stripX, stripY, adx, ch - ady);
+  }
+
+  return st;
+}
+
 PuglNativeView
 puglGetNativeView(const PuglView* const view)
 {
@@ -2440,3 +3520,127 @@ puglX11Configure(PuglView* view)
 
   return PUGL_SUCCESS;
 }
+
+PuglStatus
+puglX11ScrollWindow(PuglView* const view,
+                    const PuglRect  rect,
+                    const int       dx,
+                    const int       dy)
+{
+  Display* const display = view->world->impl->display;
+  const Window   win     = view->impl->win;
+  const int      srcX    = rect.x + MAX(-dx, 0);
+  const int      srcY    = rect.y + MAX(-dy, 0);
+
+  /* Copy within the window, which sends a GraphicsExpose for any part of the
+     source that isn't available, for example if it's covered. */
+  GC const gc = XCreateGC(display, win, 0, NULL);
+  XCopyArea(display,
+            win,
+            win,
+            gc,
+            srcX,
+            srcY,
+            rect.width - (unsigned)abs(dx),
+            rect.height - (unsigned)abs(dy),
+            srcX + dx,
+            srcY + dy);
+
+  XFreeGC(display, gc);
+  return PUGL_SUCCESS;
+}
+
+bool
+puglX11CanPresent(const PuglView* const view)
+{
+  return view->world->impl->presentOpcode != 0;
+}
+
+bool
+puglX11PixmapIsBusy(const PuglView* const view, const Pixmap pixmap)
+{
+  for (size_t i = 0U; i < view->impl->numBusyPixmaps; ++i) {
+    if (view->impl->busyPixmaps[i] == pixmap) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+PuglStatus
+puglX11PresentPixmap(PuglView* const       view,
+                     const Pixmap          pixmap,
+                     const PuglRect* const rects,
+                     const size_t          numRects)
+{
+#if USE_XPRESENT
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+
+  if (!puglX11CanPresent(view)) {
+    return PUGL_UNSUPPORTED;
+  }
+
+  // Fail if the pixmap can't be tracked, so the caller falls back to copying
+  const bool busy = puglX11PixmapIsBusy(view, pixmap);
+  if (!busy && impl->numBusyPixmaps >= PUGL_X11_MAX_BUSY_PIXMAPS) {
+    return PUGL_FAILURE;
+  }
+
+  // Select present events the first time a frame is presented
+  if (!impl->presentEventId) {
+    impl->presentEventId = XPresentSelectInput(
+      display, impl->win, PresentCompleteNotifyMask | PresentIdleNotifyMask);
+  }
+
+  // Make a region of the updated rectangles
+  XRectangle   xrects[PUGL_MAX_DAMAGE_RECTS];
+  const size_t numXRects = MIN(numRects, PUGL_MAX_DAMAGE_RECTS);
+  for (size_t i = 0U; i < numXRects; ++i) {
+    xrects[i].x      = (short)rects[i].x;
+    xrects[i].y      = (short)rects[i].y;
+    xrects[i].width  = (unsigned short)rects[i].width;
+    xrects[i].height = (unsigned short)rects[i].height;
+  }
+
+  const XserverRegion region =
+    XFixesCreateRegion(display, xrects, (int)numXRects);
+
+  /* Present the pixmap at the next refresh.  Only the updated region has
+     valid contents, so the server copies it rather than flipping. */
+  XPresentPixmap(display,
+                 impl->win,
+                 pixmap,
+                 ++impl->presentSerial,
+                 region,
+                 region,
+                 0,
+                 0,
+                 None,
+                 None,
+                 None,
+                 PresentOptionNone,
+                 0U,
+                 0U,
+                 0U,
+                 NULL,
+                 0);
+
+  XFixesDestroyRegion(display, region);
+
+  // Track the pixmap as busy until the server is finished with it
+  if (!busy) {
+    impl->busyPixmaps[impl->numBusyPixmaps++] = pixmap;
+  }
+
+  impl->presentPending = true;
+  return PUGL_SUCCESS;
+#else
+  (void)view;
+  (void)pixmap;
+  (void)rects;
+  (void)numRects;
+  return PUGL_UNSUPPORTED;
+#endif
+}
@@ -13,11 +13,19 @@
 #include <X11/X.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <poll.h>
 
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/// Maximum number of separate rectangles in the damage region of a view
+#define PUGL_MAX_DAMAGE_RECTS 8U
+
+/// Maximum number of presented pixmaps tracked until they're idle
+#define PUGL_X11_MAX_BUSY_PIXMAPS 4U
+
+/// Atoms interned at startup (must match atomNames in x11.c)
 typedef struct {
   Atom CLIPBOARD;
   Atom UTF8_STRING;
@@ -60,10 +68,13 @@ typedef struct {
   Atom text_uri_list;
 } PuglX11Atoms;
 
+/// A client-side timer in the world's timer heap
 typedef struct {
-  XID       alarm;
-  PuglView* view;
-  uintptr_t id;
+  PuglView* view;     ///< View to send timer events to
+  uintptr_t id;       ///< Application ID for the timer
+  double    period;   ///< Timer period in seconds
+  double    deadline; ///< Time of the next expiry in seconds
+  size_t    index;    ///< Index in the world timer heap
 } PuglTimer;
 
 typedef struct {
@@ -80,34 +91,115 @@ typedef struct {
   PuglBlob       data;
 } PuglX11Clipboard;
 
+/// An external file descriptor watched by the event loop
+typedef struct {
+  PuglWatchFunc  func;  ///< Function to call when ready
+  void*          data;  ///< User data for func
+  PuglWatchFlags flags; ///< Conditions to watch for
+} PuglWatch;
+
+/// An event posted from another thread to the lock-free queue
+typedef struct {
+  size_t    sequence; ///< Position this cell is ready for (atomic)
+  PuglView* view;     ///< View to send the event to
+  uintptr_t data1;    ///< Client-specific data
+  uintptr_t data2;    ///< Client-specific data
+} PuglPostedEvent;
+
+/// Function to free data that a graphics backend has cached in the world
+typedef void (*PuglX11FreeCacheFunc)(Display* display, void* cache);
+
+/// Function to swap the buffers of views that were drawn in an update
+typedef void (*PuglX11SwapFunc)(PuglWorld* world);
+
+/// Function to dispatch present events for a view's frames that were shown
+typedef PuglStatus (*PuglX11PollFunc)(PuglView* view);
+
 struct PuglWorldInternalsImpl {
-  Display*     display;
-  PuglX11Atoms atoms;
-  XIM          xim;
-  double       scaleFactor;
-  PuglTimer*   timers;
-  size_t       numTimers;
-  XID          serverTimeCounter;
-  int          syncEventBase;
-  bool         syncSupported;
+  Display*             display;
+  PuglX11Atoms         atoms;
+  XContext             viewContext;
+  XIM                  xim;
+  double               scaleFactor;
+  PuglTimer**          timers;
+  size_t               numTimers;
+  size_t               maxTimers;
+  struct pollfd*       pollFds;
+  PuglWatch*           watches;
+  size_t               numWatches;
+  int                  wakeFds[2];
+  bool                 wakePending;
+  size_t               postHead;
+  size_t               postTail;
+  PuglPostedEvent*     posted;
+  PuglWorldFlags       flags;
+  int                  presentOpcode;
+  void*                glCache;
+  PuglX11FreeCacheFunc freeGlCache;
+  PuglX11SwapFunc      swapGlViews;
 };
 
 struct PuglInternalsImpl {
-  XVisualInfo*     vi;
-  Window           win;
-  XIC              xic;
-  PuglSurface*     surface;
-  PuglEvent        pendingExpose;
-  PuglX11Clipboard clipboard;
-  long             frameExtentLeft;
-  long             frameExtentTop;
-  PuglX11Clipboard drag;
-  int              screen;
-  const char*      cursorName;
-  bool             mapped;
+  XVisualInfo*       vi;
+  Window             win;
+  XIC                xic;
+  PuglSurface*       surface;
+  PuglEvent          pendingConfigure;
+  PuglEvent          pendingPointer;
+  PuglEvent          pendingExpose;
+  PuglRect           damage[PUGL_MAX_DAMAGE_RECTS];
+  size_t             numDamageRects;
+  PuglConfigureEvent configuration;
+  PuglX11Clipboard   clipboard;
+  long               frameExtentLeft;
+  long               frameExtentTop;
+  PuglX11Clipboard   drag;
+  PuglTimer**        timers;
+  size_t             numTimers;
+  size_t             maxTimers;
+  int                frameOffsetX;
+  int                frameOffsetY;
+  int                screen;
+  const char*        cursorName;
+  Pixmap             busyPixmaps[PUGL_X11_MAX_BUSY_PIXMAPS];
+  size_t             numBusyPixmaps;
+  XID                presentEventId;
+  uint32_t           presentSerial;
+  bool               presentPending;
+  PuglX11PollFunc    pollPresents;
+  size_t             numPendingPresents;
+  double             nextPresentTime;
+  bool               mapped;
+  bool               reparented;
 };
 
 PUGL_WARN_UNUSED_RESULT PUGL_API PuglStatus
 puglX11Configure(PuglView* view);
 
+/// Copy a rectangle of a view's window by an offset, revealing a strip
+PUGL_WARN_UNUSED_RESULT PUGL_API PuglStatus
+puglX11ScrollWindow(PuglView* view, PuglRect rect, int dx, int dy);
+
+/// Return true if pixmaps can be presented to windows at the display refresh
+PUGL_API bool
+puglX11CanPresent(const PuglView* view);
+
+/// Return true if a presented pixmap may still be read by the server
+PUGL_API bool
+puglX11PixmapIsBusy(const PuglView* view, Pixmap pixmap);
+
+/**
+   Present rectangles of a pixmap to a view's window at the next refresh.
+
+   Until the frame is shown, the view won't be exposed again, and the pixmap
+   shouldn't be drawn to until it's no longer busy.  This fails without
+   presenting if too many pixmaps are already busy to track another, in which
+   case the caller should copy the pixmap to the window instead.
+*/
+PUGL_WARN_UNUSED_RESULT PUGL_API PuglStatus
+puglX11PresentPixmap(PuglView*       view,
+                     Pixmap          pixmap,
+                     const PuglRect* rects,
+                     size_t          numRects);
+
 #endif // PUGL_SRC_X11_H
@@ -1,40 +1,124 @@
-// Copyright 2012-2023 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #include "macros.h"
 #include "types.h"
 #include "x11.h"
+#include "x11_image.h"
 
 #include <pugl/cairo.h>
 #include <pugl/pugl.h>
 
+#include <X11/X.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
 #include <cairo-xlib.h>
 #include <cairo.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef struct {
-  cairo_surface_t* back;
-  cairo_surface_t* front;
-  cairo_t*         cr;
+  cairo_surface_t*      back;    ///< Window surface (server surfaces only)
+  cairo_surface_t*      front;   ///< Surface for drawing
+  cairo_surface_t*      spare;   ///< Other front surface while presenting
+  cairo_t*              cr;      ///< Drawing context during an expose
+  PuglX11Image          image;   ///< Front image data (image surfaces only)
+  PuglX11PresentPixmaps pixmaps; ///< Pixmaps for presenting the image
+  GC                    gc;      ///< Graphics context for putting images
+  PuglSpan              width;   ///< Width of surfaces
+  PuglSpan              height;  ///< Height of surfaces
+  int                   type;    ///< Surface type (a #PuglViewHintValue)
+  bool                  present; ///< True if frames are shown at the refresh
+  bool                  pending; ///< True if a shared image put is in progress
 } PuglX11CairoSurface;
 
-static PuglArea
-puglX11CairoGetViewSize(const PuglView* const view)
+/// Clip to the exposed region, which may be several rectangles
+static void
+puglX11CairoClip(const PuglView* const        view,
+                 cairo_t* const               cr,
+                 const PuglExposeEvent* const expose)
 {
-  PuglArea size = {0U, 0U};
-
-  if (view->lastConfigure.type == PUGL_CONFIGURE) {
-    // Use the size of the last configured frame
-    size.width  = view->lastConfigure.width;
-    size.height = view->lastConfigure.height;
+  if (view->numExposeRects) {
+    for (size_t i = 0U; i < view->numExposeRects; ++i) {
+      const PuglRect* const rect = &view->exposeRects[i];
+      cairo_rectangle(cr, rect->x, rect->y, rect->width, rect->height);
+    }
   } else {
-    // Use the default size
-    size.width  = view->sizeHints[PUGL_DEFAULT_SIZE].width;
-    size.height = view->sizeHints[PUGL_DEFAULT_SIZE].height;
+    cairo_rectangle(cr, expose->x, expose->y, expose->width, expose->height);
+  }
+
+  cairo_clip(cr);
+}
+
+/// Return the Cairo image format that matches the view's visual
+static cairo_format_t
+puglX11CairoImageFormat(const PuglView* const view)
+{
+  return view->impl->vi->depth == 32 ? CAIRO_FORMAT_ARGB32
+                                     : CAIRO_FORMAT_RGB24;
+}
+
+/// Return the type of surface to use, based on the hint and the display
+static int
+puglX11CairoSurfaceType(const PuglView* const view)
+{
+  const int hint = view->hints[PUGL_SURFACE_TYPE];
+
+  // Client-side images must have the same pixel layout as Cairo
+  if ((hint != PUGL_IMAGE_SURFACE && hint != PUGL_SHARED_IMAGE_SURFACE) ||
+      !puglX11ImageHasCompatibleVisual(view->impl->vi)) {
+    return PUGL_SERVER_SURFACE;
+  }
+
+  return (hint == PUGL_SHARED_IMAGE_SURFACE &&
+          puglX11ImageCanShare(view->world->impl->display))
+           ? PUGL_SHARED_IMAGE_SURFACE
+           : PUGL_IMAGE_SURFACE;
+}
+
+/// Create a new front surface to draw to, which may be a client-side image
+static cairo_surface_t*
+puglX11CairoCreateFront(PuglView* const view,
+                        const PuglSpan  width,
+                        const PuglSpan  height)
+{
+  PuglInternals* const       impl    = view->impl;
+  PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+  Display* const             display = view->world->impl->display;
+
+  if (surface->type == PUGL_SERVER_SURFACE) {
+    // Create the back surface for the window, or just update its size
+    if (!surface->back) {
+      surface->back = cairo_xlib_surface_create(
+        display, impl->win, impl->vi->visual, width, height);
+    } else {
+      cairo_xlib_surface_set_size(surface->back, width, height);
+    }
+
+    // Draw to a server pixmap which is copied to the back surface
+    return cairo_surface_create_similar(
+      surface->back, cairo_surface_get_content(surface->back), width, height);
+  }
+
+  // Draw to a client-side image which is put to the window directly
+  const bool shared = surface->type == PUGL_SHARED_IMAGE_SURFACE;
+  if (puglX11CreateImage(view, &surface->image, shared, width, height)) {
+    return NULL;
+  }
+
+  if (!surface->gc) {
+    surface->gc = XCreateGC(display, impl->win, 0, NULL);
   }
 
-  return size;
+  XImage* const ximage = surface->image.ximage;
+  return cairo_image_surface_create_for_data((unsigned char*)ximage->data,
+                                             puglX11CairoImageFormat(view),
+                                             width,
+                                             height,
+                                             ximage->bytes_per_line);
 }
 
 static void
@@ -42,10 +126,21 @@ puglX11CairoClose(PuglView* view)
 {
   PuglInternals* const       impl    = view->impl;
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+  Display* const             display = view->world->impl->display;
 
+  cairo_surface_destroy(surface->spare);
   cairo_surface_destroy(surface->front);
   cairo_surface_destroy(surface->back);
-  surface->front = surface->back = NULL;
+  puglX11DestroyImage(display, &surface->image);
+  puglX11FreePresentPixmaps(display, &surface->pixmaps);
+  if (surface->gc) {
+    XFreeGC(display, surface->gc);
+  }
+
+  surface->spare = surface->front = surface->back = NULL;
+  surface->gc                    = NULL;
+  surface->width = surface->height = 0U;
+  surface->pending                 = false;
 }
 
 static PuglStatus
@@ -53,29 +148,117 @@ puglX11CairoOpen(PuglView* view, const PuglSpan width, const PuglSpan height)
 {
   PuglInternals* const       impl    = view->impl;
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+  Display* const             display = view->world->impl->display;
+
+  // Reuse the surfaces from previous exposes if the size hasn't changed
+  if (surface->front && width == surface->width &&
+      height == surface->height) {
+    return PUGL_SUCCESS;
+  }
+
+  // Replace the front surface with one of the new size
+  cairo_surface_t* const oldFront = surface->front;
+  PuglX11Image           oldImage = surface->image;
 
-  surface->back = cairo_xlib_surface_create(
-    view->world->impl->display, impl->win, impl->vi->visual, width, height);
+  memset(&surface->image, 0, sizeof(surface->image));
+  while (!(surface->front = puglX11CairoCreateFront(view, width, height))) {
+    // Fall back to a simpler type of surface, and update the hint to match
+    surface->type = (surface->type == PUGL_SHARED_IMAGE_SURFACE)
+                      ? PUGL_IMAGE_SURFACE
+                      : PUGL_SERVER_SURFACE;
 
-  surface->front = cairo_surface_create_similar(
-    surface->back, cairo_surface_get_content(surface->back), width, height);
+    view->hints[PUGL_SURFACE_TYPE] = surface->type;
+  }
+
+  // Copy the previous contents to the new front surface if they're preserved
+  if (oldFront && view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE &&
+      !cairo_surface_status(surface->front)) {
+    cairo_t* const cr = cairo_create(surface->front);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(cr, oldFront, 0, 0);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+  }
 
-  if (cairo_surface_status(surface->back) ||
+  cairo_surface_destroy(surface->spare);
+  cairo_surface_destroy(oldFront);
+  puglX11DestroyImage(display, &oldImage);
+  surface->spare = NULL;
+  if ((surface->back && cairo_surface_status(surface->back)) ||
       cairo_surface_status(surface->front)) {
     puglX11CairoClose(view);
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
+  surface->width  = width;
+  surface->height = height;
   return PUGL_SUCCESS;
 }
 
+/// Switch to the spare front surface if the server is presenting the front
+static void
+puglX11CairoSwapFront(PuglView* const view)
+{
+  PuglInternals* const       impl    = view->impl;
+  PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+  cairo_surface_t* const     front   = surface->front;
+
+  if (!surface->present || surface->image.ximage ||
+      !puglX11PixmapIsBusy(view, cairo_xlib_surface_get_drawable(front))) {
+    return;
+  }
+
+  // Create the spare surface the first time the front is busy
+  if (!surface->spare) {
+    surface->spare = cairo_surface_create_similar(
+      front, cairo_surface_get_content(front), surface->width, surface->height);
+
+    if (cairo_surface_status(surface->spare)) {
+      cairo_surface_destroy(surface->spare);
+      surface->spare = NULL;
+      return;
+    }
+  } else if (puglX11PixmapIsBusy(
+               view, cairo_xlib_surface_get_drawable(surface->spare))) {
+    return;
+  }
+
+  surface->front = surface->spare;
+  surface->spare = front;
+
+  // Copy the previous contents to the new front surface if they're preserved
+  if (view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE) {
+    cairo_t* const cr = cairo_create(surface->front);
+    cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(cr, front, 0, 0);
+    cairo_paint(cr);
+    cairo_destroy(cr);
+  }
+}
+
 static PuglStatus
 puglX11CairoCreate(PuglView* view)
 {
   PuglInternals* const impl = view->impl;
 
-  impl->surface = (cairo_surface_t*)calloc(1, sizeof(PuglX11CairoSurface));
+  PuglX11CairoSurface* const surface =
+    (PuglX11CairoSurface*)calloc(1, sizeof(PuglX11CairoSurface));
+
+  if (!surface) {
+    return PUGL_NO_MEMORY;
+  }
+
+  // Choose the surface type now and set the hint to report it
+  surface->type                  = puglX11CairoSurfaceType(view);
+  view->hints[PUGL_SURFACE_TYPE] = surface->type;
+
+  // Present frames at the refresh if a swap interval is requested
+  surface->present = view->hints[PUGL_SWAP_INTERVAL] >= 1 &&
+                     puglX11CanPresent(view);
+
+  view->hints[PUGL_SWAP_INTERVAL] = surface->present ? 1 : 0;
 
+  impl->surface = (cairo_surface_t*)surface;
   return PUGL_SUCCESS;
 }
 
@@ -85,8 +268,10 @@ puglX11CairoDestroy(PuglView* view)
   PuglInternals* const       impl    = view->impl;
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
 
-  puglX11CairoClose(view);
-  free(surface);
+  if (surface) {
+    puglX11CairoClose(view);
+    free(surface);
+  }
 }
 
 static PuglStatus
@@ -97,17 +282,27 @@ puglX11CairoEnter(PuglView* view, const PuglExposeEvent* expose)
   PuglStatus                 st      = PUGL_SUCCESS;
 
   if (expose) {
-    const PuglArea viewSize      = puglX11CairoGetViewSize(view);
+    // Wait until the server has finished reading the last shared image
+    if (surface->pending) {
+      XSync(view->world->impl->display, False);
+      surface->pending = false;
+    }
+
+    const PuglArea viewSize      = puglX11GetViewSize(view);
     const PuglSpan right         = (PuglSpan)(expose->x + expose->width);
     const PuglSpan bottom        = (PuglSpan)(expose->y + expose->height);
     const PuglSpan surfaceWidth  = MAX(right, viewSize.width);
     const PuglSpan surfaceHeight = MAX(bottom, viewSize.height);
     if (!(st = puglX11CairoOpen(view, surfaceWidth, surfaceHeight))) {
+      puglX11CairoSwapFront(view);
       surface->cr = cairo_create(surface->front);
       if (cairo_status(surface->cr)) {
         cairo_destroy(surface->cr);
         surface->cr = NULL;
         st          = PUGL_CREATE_CONTEXT_FAILED;
+      } else {
+        // Skip drawing anything outside the exposed region
+        puglX11CairoClip(view, surface->cr, expose);
       }
     }
   }
@@ -121,30 +316,108 @@ puglX11CairoLeave(PuglView* view, const PuglExposeEvent* expose)
   PuglInternals* const       impl    = view->impl;
   PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
 
-  if (expose) {
-    // Destroy front context and create a new one for drawing to the back
-    cairo_destroy(surface->cr);
-    surface->cr = cairo_create(surface->back);
-
-    // Clip to expose region
-    cairo_rectangle(
-      surface->cr, expose->x, expose->y, expose->width, expose->height);
-    cairo_clip(surface->cr);
-
-    // Paint front onto back
-    cairo_set_source_surface(surface->cr, surface->front, 0, 0);
-    cairo_paint(surface->cr);
-
-    // Flush to X and close everything
-    cairo_destroy(surface->cr);
-    cairo_surface_flush(surface->back);
-    puglX11CairoClose(view);
-    surface->cr = NULL;
+  if (!expose) {
+    return PUGL_SUCCESS;
+  }
+
+  const PuglRect bounds = {
+    expose->x, expose->y, expose->width, expose->height};
+
+  const bool      hasRects = view->numExposeRects > 0U;
+  const PuglRect* rects    = hasRects ? view->exposeRects : &bounds;
+  const size_t    numRects = hasRects ? view->numExposeRects : 1U;
+
+  // Finish drawing to the front surface
+  cairo_destroy(surface->cr);
+  cairo_surface_flush(surface->front);
+  surface->cr = NULL;
+
+  if (surface->image.ximage) {
+    // Show the exposed region of the image
+    if (puglX11ShowImage(view,
+                         &surface->image,
+                         surface->gc,
+                         surface->present ? &surface->pixmaps : NULL,
+                         rects,
+                         numRects)) {
+      surface->pending = true;
+    }
+  } else {
+    // Present the front pixmap, or paint it to the window if that fails
+    const Drawable pixmap = cairo_xlib_surface_get_drawable(surface->front);
+    if (!surface->present ||
+        puglX11PresentPixmap(view, pixmap, rects, numRects)) {
+      surface->cr = cairo_create(surface->back);
+      puglX11CairoClip(view, surface->cr, expose);
+      cairo_set_source_surface(surface->cr, surface->front, 0, 0);
+      cairo_paint(surface->cr);
+
+      // Flush to X, but keep the surfaces for the next expose
+      cairo_destroy(surface->cr);
+      cairo_surface_flush(surface->back);
+      surface->cr = NULL;
+    }
   }
 
   return PUGL_SUCCESS;
 }
 
+static PuglStatus
+puglX11CairoScroll(PuglView* const view,
+                   const PuglRect  rect,
+                   const int       dx,
+                   const int       dy)
+{
+  PuglInternals* const       impl    = view->impl;
+  PuglX11CairoSurface* const surface = (PuglX11CairoSurface*)impl->surface;
+  Display* const             display = view->world->impl->display;
+
+  // Move the contents of the front surface too if they're preserved
+  if (view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE && surface->front) {
+    if (rect.x + rect.width > (int)surface->width ||
+        rect.y + rect.height > (int)surface->height) {
+      return PUGL_FAILURE;
+    }
+
+    cairo_surface_flush(surface->front);
+    if (surface->image.ximage) {
+      if (surface->pending) {
+        XSync(display, False);
+        surface->pending = false;
+      }
+
+      puglX11ScrollImage(surface->image.ximage, rect, dx, dy);
+    } else {
+      const Drawable pixmap = cairo_xlib_surface_get_drawable(surface->front);
+      const int      srcX   = rect.x + MAX(-dx, 0);
+      const int      srcY   = rect.y + MAX(-dy, 0);
+      XGCValues      values = {0};
+
+      // The whole pixmap is available, so no exposures are needed
+      values.graphics_exposures = False;
+      GC const gc = XCreateGC(display, pixmap, GCGraphicsExposures, &values);
+
+      XCopyArea(display,
+                pixmap,
+                pixmap,
+                gc,
+                srcX,
+                srcY,
+                rect.width - (unsigned)abs(dx),
+                rect.height - (unsigned)abs(dy),
+                srcX + dx,
+                srcY + dy);
+
+      XFreeGC(display, gc);
+    }
+
+    cairo_surface_mark_dirty_rectangle(
+      surface->front, rect.x, rect.y, rect.width, rect.height);
+  }
+
+  return puglX11ScrollWindow(view, rect, dx, dy);
+}
+
 static void*
 puglX11CairoGetContext(PuglView* view)
 {
@@ -162,7 +435,8 @@ puglCairoBackend(void)
                                       puglX11CairoDestroy,
                                       puglX11CairoEnter,
                                       puglX11CairoLeave,
-                                      puglX11CairoGetContext};
+                                      puglX11CairoGetContext,
+                                      puglX11CairoScroll};
 
   return &backend;
 }
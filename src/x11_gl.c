@@ -1,7 +1,9 @@
-// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #include "attributes.h"
+#include "internal.h"
+#include "macros.h"
 #include "stub.h"
 #include "types.h"
 #include "x11.h"
@@ -9,17 +11,105 @@
 #include <pugl/gl.h>
 #include <pugl/pugl.h>
 
+#include <GL/gl.h>
 #include <GL/glx.h>
 #include <X11/X.h>
 #include <X11/Xlib.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+/// Number of hints that determine the framebuffer configuration
+#define PUGL_X11_GL_NUM_CONFIG_HINTS 9U
+
+/// Maximum number of swaps that are tracked until they're shown
+#define PUGL_X11_GL_MAX_SWAPS 4U
+
+/// Framebuffer configuration hints and the corresponding GLX attributes
+static const PuglViewHint puglX11GlConfigHints[] = {
+  PUGL_SAMPLE_BUFFERS,
+  PUGL_SAMPLES,
+  PUGL_RED_BITS,
+  PUGL_GREEN_BITS,
+  PUGL_BLUE_BITS,
+  PUGL_ALPHA_BITS,
+  PUGL_DEPTH_BITS,
+  PUGL_STENCIL_BITS,
+  PUGL_DOUBLE_BUFFER,
+};
+
+static const int puglX11GlConfigAttribs[] = {
+  GLX_SAMPLE_BUFFERS,
+  GLX_SAMPLES,
+  GLX_RED_SIZE,
+  GLX_GREEN_SIZE,
+  GLX_BLUE_SIZE,
+  GLX_ALPHA_SIZE,
+  GLX_DEPTH_SIZE,
+  GLX_STENCIL_SIZE,
+  GLX_DOUBLEBUFFER,
+};
+
+/// A framebuffer configuration chosen for a screen and set of hints
 typedef struct {
-  GLXFBConfig fb_config;
-  GLXContext  ctx;
+  int         screen;                                  ///< Screen number
+  int         requested[PUGL_X11_GL_NUM_CONFIG_HINTS]; ///< Hint values
+  int         actual[PUGL_X11_GL_NUM_CONFIG_HINTS];    ///< Actual values
+  GLXFBConfig fbConfig;                                ///< Chosen config
+  VisualID    visualId;                                ///< Visual of config
+  bool        hasCreateContext; ///< True if GLX_ARB_create_context is there
+  bool        hasSwapControl;   ///< True if GLX_EXT_swap_control is there
+  bool        hasBufferAge;     ///< True if GLX_EXT_buffer_age is there
+  bool        hasCopySubBuffer; ///< True if GLX_MESA_copy_sub_buffer is there
+  bool        hasSyncControl;   ///< True if GLX_OML_sync_control is there
+} PuglX11GlConfig;
+
+/**
+   GLX state cached in the world.
+
+   Choosing a configuration and querying extensions involves several round
+   trips to the server, which adds up when many views are realized at once,
+   so the results are cached and reused for views with the same hints.
+*/
+typedef struct {
+  PuglX11GlConfig*                  configs;         ///< Chosen configurations
+  size_t                            numConfigs;      ///< Size of configs
+  PFNGLXCREATECONTEXTATTRIBSARBPROC createContext;   ///< Context creation
+  PFNGLXSWAPINTERVALEXTPROC         swapInterval;    ///< Swap interval setter
+  PFNGLXCOPYSUBBUFFERMESAPROC       copySubBuffer;   ///< Back buffer copier
+  PFNGLXGETSYNCVALUESOMLPROC        getSyncValues;   ///< UST/MSC/SBC getter
+  PFNGLXGETMSCRATEOMLPROC           getMscRate;      ///< Refresh rate getter
+  PFNGLXWAITFORSBCOMLPROC           waitForSbc;      ///< Swap completion waiter
+  PFNGLBINDFRAMEBUFFERPROC          bindFramebuffer; ///< Framebuffer binder
+  PFNGLBLITFRAMEBUFFERPROC          blitFramebuffer; ///< Framebuffer copier
+} PuglX11GlCache;
+
+/// A swap that was issued but hasn't been reported as shown yet
+typedef struct {
+  int64_t  sbc;       ///< Swap buffer count when the swap is complete
+  int64_t  msc;       ///< Refresh count when the frame should be shown
+  double   predicted; ///< Time when the frame should be shown
+  uint32_t serial;    ///< Serial number of the frame
+} PuglX11GlSwap;
+
+typedef struct {
+  PuglX11GlConfig config;
+  GLXContext      ctx;
+  PuglArea        copiedSize;  ///< Size of the last frame copied to the window
+  unsigned        age;         ///< Age of the back buffer while drawing
+  int             interval;    ///< Current swap interval of the window
+  bool            copy;        ///< True if exposed regions are copied instead
+  bool            swapPending; ///< True if drawn but not swapped yet
+  bool            timing;      ///< True if swaps are reported when shown
+  double          period;      ///< Refresh period in seconds, or zero
+  int64_t         sbc;         ///< Swap buffer count of the last swap
+  int64_t         shownMsc;    ///< Refresh count of the last shown frame
+  uint32_t        serial;      ///< Serial number of the last swapped frame
+  size_t          numSwaps;    ///< Number of swaps not shown yet
+  PuglX11GlSwap   swaps[PUGL_X11_GL_MAX_SWAPS]; ///< Swaps not shown yet
 } PuglX11GlSurface;
 
 static int
@@ -28,45 +118,223 @@ puglX11GlHintValue(const int value)
   return value == PUGL_DONT_CARE ? (int)GLX_DONT_CARE : value;
 }
 
-static int
-puglX11GlGetAttrib(Display* const display,
-                   GLXFBConfig    fb_config,
-                   const int      attrib)
+static void
+puglX11GlFreeCache(Display* const display, void* const cache)
 {
-  int value = 0;
-  glXGetFBConfigAttrib(display, fb_config, attrib, &value);
-  return value;
+  (void)display;
+
+  free(((PuglX11GlCache*)cache)->configs);
+  free(cache);
+}
+
+/// Swap the buffers of a view, tracking the swap if timing is enabled
+static void
+puglX11GlSwap(PuglView* const view, PuglX11GlSurface* const surface)
+{
+  PuglWorld* const            world   = view->world;
+  PuglInternals* const        impl    = view->impl;
+  Display* const              display = world->impl->display;
+  const PuglX11GlCache* const cache   = (PuglX11GlCache*)world->impl->glCache;
+
+  int64_t ust = 0;
+  int64_t msc = 0;
+  int64_t sbc = 0;
+  if (!surface->timing || surface->numSwaps >= PUGL_X11_GL_MAX_SWAPS ||
+      !cache->getSyncValues(display, impl->win, &ust, &msc, &sbc)) {
+    // Count the swap anyway so later ones still complete at the right count
+    glXSwapBuffers(display, impl->win);
+    surface->sbc += surface->timing ? 1 : 0;
+    return;
+  }
+
+  // Predict when the frame will be shown from the last blank and interval
+  const int64_t interval = surface->interval;
+  const int64_t lastMsc  = surface->numSwaps
+                             ? surface->swaps[surface->numSwaps - 1U].msc
+                             : surface->shownMsc;
+
+  PuglX11GlSwap* const swap = &surface->swaps[surface->numSwaps++];
+
+  swap->sbc       = MAX(sbc, surface->sbc) + 1;
+  swap->msc       = MAX(msc + (interval ? 1 : 0), lastMsc + interval);
+  swap->predicted = ((double)ust / 1e6) - world->startTime +
+                    ((double)(swap->msc - msc) * surface->period);
+  swap->serial    = ++surface->serial;
+
+  glXSwapBuffers(display, impl->win);
+
+  surface->sbc          = swap->sbc;
+  impl->nextPresentTime = surface->swaps[0].predicted;
+  ++impl->numPendingPresents;
 }
 
+/// Report swaps of a view that have been shown using GLX_OML_sync_control
 static PuglStatus
-puglX11GlConfigure(PuglView* view)
+puglX11GlPollPresents(PuglView* const view)
 {
-  PuglInternals* const impl    = view->impl;
-  const int            screen  = impl->screen;
-  Display* const       display = view->world->impl->display;
+  PuglWorld* const            world   = view->world;
+  PuglInternals* const        impl    = view->impl;
+  PuglX11GlSurface* const     surface = (PuglX11GlSurface*)impl->surface;
+  Display* const              display = world->impl->display;
+  const PuglX11GlCache* const cache   = (PuglX11GlCache*)world->impl->glCache;
+  PuglStatus                  st      = PUGL_SUCCESS;
+
+  int64_t ust = 0;
+  int64_t msc = 0;
+  int64_t sbc = 0;
+  if (!cache->getSyncValues(display, impl->win, &ust, &msc, &sbc)) {
+    // Stop tracking swaps that can't be checked
+    surface->numSwaps        = 0U;
+    impl->numPendingPresents = 0U;
+    return PUGL_SUCCESS;
+  }
 
-  PuglX11GlSurface* const surface =
-    (PuglX11GlSurface*)calloc(1, sizeof(PuglX11GlSurface));
-  impl->surface = surface;
+  size_t numShown = 0U;
+  while (!st && numShown < surface->numSwaps &&
+         surface->swaps[numShown].sbc <= sbc) {
+    const PuglX11GlSwap* const swap = &surface->swaps[numShown++];
+
+    // Get when the swap completed, which doesn't block since it already has
+    int64_t swapUst = ust;
+    int64_t swapMsc = msc;
+    int64_t swapSbc = sbc;
+    cache->waitForSbc(
+      display, impl->win, swap->sbc, &swapUst, &swapMsc, &swapSbc);
+
+    surface->shownMsc = swapMsc;
+    --impl->numPendingPresents;
+
+    PuglEvent event      = {{PUGL_PRESENT, 0U}};
+    event.present.kind   = PUGL_PRESENT_COMPLETE;
+    event.present.serial = swap->serial;
+    event.present.msc    = (uint64_t)swapMsc;
+    event.present.time   = ((double)swapUst / 1e6) - world->startTime;
+    event.present.missed =
+      (swapMsc > swap->msc) ? (uint32_t)(swapMsc - swap->msc) : 0U;
+
+    st = puglDispatchEvent(view, &event);
+  }
+
+  // Remove the reported swaps and wake when the next should be shown
+  surface->numSwaps -= numShown;
+  memmove(surface->swaps,
+          surface->swaps + numShown,
+          surface->numSwaps * sizeof(PuglX11GlSwap));
+
+  impl->nextPresentTime = surface->numSwaps ? surface->swaps[0].predicted : 0.0;
+  return st;
+}
+
+/// Swap the buffers of all drawn views, so only the last waits for a blank
+static void
+puglX11GlSwapViews(PuglWorld* const world)
+{
+  Display* const              display = world->impl->display;
+  const PuglX11GlCache* const cache   = (PuglX11GlCache*)world->impl->glCache;
+  const PuglBackend* const    backend = puglGlBackend();
+
+  // Find the last view to swap, which is the only one that may wait
+  const PuglView* last = NULL;
+  for (size_t i = 0U; i < world->numViews; ++i) {
+    const PuglView* const         view    = world->views[i];
+    const PuglX11GlSurface* const surface =
+      (const PuglX11GlSurface*)view->impl->surface;
+
+    if (view->backend == backend && surface && surface->swapPending) {
+      last = view;
+    }
+  }
+
+  for (size_t i = 0U; last && i < world->numViews; ++i) {
+    PuglView* const         view    = world->views[i];
+    PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+    if (view->backend != backend || !surface || !surface->swapPending) {
+      continue;
+    }
+
+    // Set the swap interval to zero for all but the last view
+    const int interval = (view == last) ? view->hints[PUGL_SWAP_INTERVAL] : 0;
+    if (surface->config.hasSwapControl && interval >= 0 &&
+        interval != surface->interval) {
+      cache->swapInterval(display, view->impl->win, interval);
+      surface->interval = interval;
+    }
+
+    puglX11GlSwap(view, surface);
+    surface->swapPending = false;
+  }
+}
+
+/// Return the GLX cache for the world, creating it if necessary
+static PuglX11GlCache*
+puglX11GlGetCache(PuglWorld* const world)
+{
+  PuglWorldInternals* const impl = world->impl;
+
+  if (!impl->glCache) {
+    PuglX11GlCache* const cache =
+      (PuglX11GlCache*)calloc(1, sizeof(PuglX11GlCache));
+    if (!cache) {
+      return NULL;
+    }
+
+    // Resolve extension functions, which doesn't depend on the display
+    cache->createContext = (PFNGLXCREATECONTEXTATTRIBSARBPROC)glXGetProcAddress(
+      (const uint8_t*)"glXCreateContextAttribsARB");
+    cache->swapInterval = (PFNGLXSWAPINTERVALEXTPROC)glXGetProcAddress(
+      (const uint8_t*)"glXSwapIntervalEXT");
+    cache->copySubBuffer = (PFNGLXCOPYSUBBUFFERMESAPROC)glXGetProcAddress(
+      (const uint8_t*)"glXCopySubBufferMESA");
+    cache->getSyncValues = (PFNGLXGETSYNCVALUESOMLPROC)glXGetProcAddress(
+      (const uint8_t*)"glXGetSyncValuesOML");
+    cache->getMscRate = (PFNGLXGETMSCRATEOMLPROC)glXGetProcAddress(
+      (const uint8_t*)"glXGetMscRateOML");
+    cache->waitForSbc = (PFNGLXWAITFORSBCOMLPROC)glXGetProcAddress(
+      (const uint8_t*)"glXWaitForSbcOML");
+    cache->bindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)glXGetProcAddress(
+      (const uint8_t*)"glBindFramebuffer");
+    cache->blitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)glXGetProcAddress(
+      (const uint8_t*)"glBlitFramebuffer");
+
+    impl->glCache     = cache;
+    impl->freeGlCache = puglX11GlFreeCache;
+
+    // Defer swaps until all views are drawn if they should be grouped
+    if (impl->flags & PUGL_WORLD_GROUP_SWAPS) {
+      impl->swapGlViews = puglX11GlSwapViews;
+    }
+  }
 
-  // clang-format off
-  const int attrs[] = {
-    GLX_X_RENDERABLE,   True,
-    GLX_X_VISUAL_TYPE,  GLX_TRUE_COLOR,
-    GLX_DRAWABLE_TYPE,  GLX_WINDOW_BIT,
-    GLX_RENDER_TYPE,    GLX_RGBA_BIT,
-    GLX_SAMPLE_BUFFERS, puglX11GlHintValue(view->hints[PUGL_SAMPLE_BUFFERS]),
-    GLX_SAMPLES,        puglX11GlHintValue(view->hints[PUGL_SAMPLES]),
-    GLX_RED_SIZE,       puglX11GlHintValue(view->hints[PUGL_RED_BITS]),
-    GLX_GREEN_SIZE,     puglX11GlHintValue(view->hints[PUGL_GREEN_BITS]),
-    GLX_BLUE_SIZE,      puglX11GlHintValue(view->hints[PUGL_BLUE_BITS]),
-    GLX_ALPHA_SIZE,     puglX11GlHintValue(view->hints[PUGL_ALPHA_BITS]),
-    GLX_DEPTH_SIZE,     puglX11GlHintValue(view->hints[PUGL_DEPTH_BITS]),
-    GLX_STENCIL_SIZE,   puglX11GlHintValue(view->hints[PUGL_STENCIL_BITS]),
-    GLX_DOUBLEBUFFER,   puglX11GlHintValue(view->hints[PUGL_DOUBLE_BUFFER]),
-    None
+  return (PuglX11GlCache*)impl->glCache;
+}
+
+/// Choose a new configuration for the hints of a view, without the cache
+static PuglStatus
+puglX11GlChooseConfig(PuglView* const             view,
+                      const PuglX11GlCache* const cache,
+                      PuglX11GlConfig* const      config)
+{
+  Display* const display = view->world->impl->display;
+  const int      screen  = view->impl->screen;
+
+  int attrs[(2U * PUGL_X11_GL_NUM_CONFIG_HINTS) + 9U] = {
+    GLX_X_RENDERABLE,
+    True,
+    GLX_X_VISUAL_TYPE,
+    GLX_TRUE_COLOR,
+    GLX_DRAWABLE_TYPE,
+    GLX_WINDOW_BIT,
+    GLX_RENDER_TYPE,
+    GLX_RGBA_BIT,
   };
-  // clang-format on
+
+  config->screen = screen;
+  for (size_t i = 0U; i < PUGL_X11_GL_NUM_CONFIG_HINTS; ++i) {
+    config->requested[i] = view->hints[puglX11GlConfigHints[i]];
+    attrs[8U + (2U * i)] = puglX11GlConfigAttribs[i];
+    attrs[9U + (2U * i)] = puglX11GlHintValue(config->requested[i]);
+  }
+  attrs[8U + (2U * PUGL_X11_GL_NUM_CONFIG_HINTS)] = None;
 
   int          n_fbc = 0;
   GLXFBConfig* fbc   = glXChooseFBConfig(display, screen, attrs, &n_fbc);
@@ -74,34 +342,188 @@ puglX11GlConfigure(PuglView* view)
     return PUGL_CREATE_CONTEXT_FAILED;
   }
 
-  surface->fb_config = fbc[0];
-  impl->vi           = glXGetVisualFromFBConfig(display, fbc[0]);
-
-  view->hints[PUGL_RED_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_RED_SIZE);
-  view->hints[PUGL_GREEN_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_GREEN_SIZE);
-  view->hints[PUGL_BLUE_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_BLUE_SIZE);
-  view->hints[PUGL_ALPHA_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_ALPHA_SIZE);
-  view->hints[PUGL_DEPTH_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_DEPTH_SIZE);
-  view->hints[PUGL_STENCIL_BITS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_STENCIL_SIZE);
-  view->hints[PUGL_SAMPLE_BUFFERS] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_SAMPLE_BUFFERS);
-  view->hints[PUGL_SAMPLES] = puglX11GlGetAttrib(display, fbc[0], GLX_SAMPLES);
-  view->hints[PUGL_DOUBLE_BUFFER] =
-    puglX11GlGetAttrib(display, fbc[0], GLX_DOUBLEBUFFER);
+  // Get the actual values of the chosen configuration
+  int visualId = 0;
+  glXGetFBConfigAttrib(display, fbc[0], GLX_VISUAL_ID, &visualId);
+  config->fbConfig = fbc[0];
+  config->visualId = (VisualID)visualId;
+  for (size_t i = 0U; i < PUGL_X11_GL_NUM_CONFIG_HINTS; ++i) {
+    glXGetFBConfigAttrib(
+      display, fbc[0], puglX11GlConfigAttribs[i], &config->actual[i]);
+  }
 
   XFree(fbc);
 
+  // Check for extensions, which may differ between screens
+  const char* const extensions = glXQueryExtensionsString(display, screen);
+
+  config->hasCreateContext =
+    cache->createContext && !!strstr(extensions, "GLX_ARB_create_context");
+  config->hasSwapControl =
+    cache->swapInterval && !!strstr(extensions, "GLX_EXT_swap_control");
+  config->hasBufferAge = !!strstr(extensions, "GLX_EXT_buffer_age");
+  config->hasCopySubBuffer =
+    cache->copySubBuffer && !!strstr(extensions, "GLX_MESA_copy_sub_buffer");
+  config->hasSyncControl = cache->getSyncValues && cache->getMscRate &&
+                           cache->waitForSbc &&
+                           !!strstr(extensions, "GLX_OML_sync_control");
+
   return PUGL_SUCCESS;
 }
 
+/// Find a cached configuration for the hints of a view, or choose a new one
+static PuglStatus
+puglX11GlFindConfig(PuglView* const view, PuglX11GlConfig* const config)
+{
+  PuglX11GlCache* const cache = puglX11GlGetCache(view->world);
+  if (!cache) {
+    return PUGL_NO_MEMORY;
+  }
+
+  // Search for a configuration that was chosen for the same hints
+  for (size_t i = 0U; i < cache->numConfigs; ++i) {
+    const PuglX11GlConfig* const cached = &cache->configs[i];
+    bool                         match  = cached->screen == view->impl->screen;
+    for (size_t h = 0U; match && h < PUGL_X11_GL_NUM_CONFIG_HINTS; ++h) {
+      match = cached->requested[h] == view->hints[puglX11GlConfigHints[h]];
+    }
+
+    if (match) {
+      *config = *cached;
+      return PUGL_SUCCESS;
+    }
+  }
+
+  // Choose a new configuration and add it to the cache
+  const PuglStatus st = puglX11GlChooseConfig(view, cache, config);
+  if (!st) {
+    PuglX11GlConfig* const configs = (PuglX11GlConfig*)realloc(
+      cache->configs, (cache->numConfigs + 1U) * sizeof(PuglX11GlConfig));
+
+    if (configs) {
+      cache->configs                      = configs;
+      cache->configs[cache->numConfigs++] = *config;
+    }
+  }
+
+  return st;
+}
+
+/// Return the context of the view to share resources with, if it's usable
+static GLXContext
+puglX11GlGetSharedContext(const PuglView* const view)
+{
+  const PuglView* const other = view->sharedView;
+  if (!other || other->backend != view->backend) {
+    return NULL;
+  }
+
+  const PuglX11GlSurface* const surface =
+    (const PuglX11GlSurface*)other->impl->surface;
+
+  return (surface && surface->config.screen == view->impl->screen)
+           ? surface->ctx
+           : NULL;
+}
+
+static PuglStatus
+puglX11GlConfigure(PuglView* view)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+  PuglStatus           st      = PUGL_SUCCESS;
+
+  PuglX11GlSurface* const surface =
+    (PuglX11GlSurface*)calloc(1, sizeof(PuglX11GlSurface));
+  impl->surface = surface;
+
+  if (!surface) {
+    return PUGL_NO_MEMORY;
+  }
+
+  // Check that the view to share with is usable before making a window
+  if (view->sharedView && !puglX11GlGetSharedContext(view)) {
+    return PUGL_BAD_CONFIGURATION;
+  }
+
+  if ((st = puglX11GlFindConfig(view, &surface->config))) {
+    return st;
+  }
+
+  // Get the visual, which is looked up locally without a round trip
+  XVisualInfo pat = {0};
+  int         n   = 0;
+  pat.visualid    = surface->config.visualId;
+  if (!(impl->vi = XGetVisualInfo(display, VisualIDMask, &pat, &n))) {
+    return PUGL_BAD_CONFIGURATION;
+  }
+
+  for (size_t i = 0U; i < PUGL_X11_GL_NUM_CONFIG_HINTS; ++i) {
+    view->hints[puglX11GlConfigHints[i]] = surface->config.actual[i];
+  }
+
+  return PUGL_SUCCESS;
+}
+
+/// Return the age of the back buffer, which must be current
+static unsigned
+puglX11GlQueryBufferAge(const PuglView* const view)
+{
+  const PuglX11GlSurface* const surface =
+    (const PuglX11GlSurface*)view->impl->surface;
+
+  if (surface->copy) {
+    // The back buffer is never swapped, so it has the last frame if it fits
+    return (surface->copiedSize.width == view->lastConfigure.width &&
+            surface->copiedSize.height == view->lastConfigure.height)
+             ? 1U
+             : 0U;
+  }
+
+  unsigned age = 0U;
+  if (surface->config.hasBufferAge) {
+    glXQueryDrawable(view->world->impl->display,
+                     view->impl->win,
+                     GLX_BACK_BUFFER_AGE_EXT,
+                     &age);
+  }
+
+  return age;
+}
+
+/// Copy the exposed region of the back buffer to the window
+static void
+puglX11GlCopyExposed(PuglView* const view, const PuglExposeEvent* const expose)
+{
+  PuglX11GlSurface* const     surface = (PuglX11GlSurface*)view->impl->surface;
+  const PuglX11GlCache* const cache   = puglX11GlGetCache(view->world);
+  Display* const              display = view->world->impl->display;
+  const PuglSpan              width   = view->lastConfigure.width;
+  const PuglSpan              height  = view->lastConfigure.height;
+
+  const PuglRect bounds = {expose->x, expose->y, expose->width, expose->height};
+
+  const bool      hasRects = view->numExposeRects > 0U;
+  const PuglRect* rects    = hasRects ? view->exposeRects : &bounds;
+  const size_t    numRects = hasRects ? view->numExposeRects : 1U;
+
+  // Copy each rectangle, which is flipped since GL coordinates start below
+  for (size_t i = 0U; i < numRects; ++i) {
+    const PuglRect r = rects[i];
+    cache->copySubBuffer(display,
+                         view->impl->win,
+                         r.x,
+                         (int)height - (r.y + (int)r.height),
+                         (int)r.width,
+                         (int)r.height);
+  }
+
+  surface->copiedSize.width  = width;
+  surface->copiedSize.height = height;
+}
+
 PUGL_WARN_UNUSED_RESULT static PuglStatus
-puglX11GlEnter(PuglView* view, const PuglExposeEvent* PUGL_UNUSED(expose))
+puglX11GlEnter(PuglView* view, const PuglExposeEvent* expose)
 {
   PuglX11GlSurface* surface = (PuglX11GlSurface*)view->impl->surface;
   Display* const    display = view->world->impl->display;
@@ -109,30 +531,178 @@ puglX11GlEnter(PuglView* view, const PuglExposeEvent* PUGL_UNUSED(expose))
     return PUGL_FAILURE;
   }
 
-  return glXMakeCurrent(display, view->impl->win, surface->ctx) ? PUGL_SUCCESS
-                                                                : PUGL_FAILURE;
+  // Leave the context to the render thread when dispatching exposes
+  if (expose && view->hints[PUGL_RENDER_THREAD] == PUGL_TRUE) {
+    return PUGL_SUCCESS;
+  }
+
+  if (!glXMakeCurrent(display, view->impl->win, surface->ctx)) {
+    return PUGL_FAILURE;
+  }
+
+  if (expose) {
+    surface->age = puglX11GlQueryBufferAge(view);
+  }
+
+  return PUGL_SUCCESS;
 }
 
 PUGL_WARN_UNUSED_RESULT static PuglStatus
 puglX11GlLeave(PuglView* view, const PuglExposeEvent* expose)
 {
-  Display* const display = view->world->impl->display;
+  PuglWorld* const        world   = view->world;
+  PuglX11GlSurface* const surface = (PuglX11GlSurface*)view->impl->surface;
+  Display* const          display = world->impl->display;
+
+  if (expose && view->hints[PUGL_RENDER_THREAD] == PUGL_TRUE) {
+    return PUGL_SUCCESS;
+  }
 
   if (expose && view->hints[PUGL_DOUBLE_BUFFER]) {
-    glXSwapBuffers(display, view->impl->win);
+    if (surface->copy) {
+      puglX11GlCopyExposed(view, expose);
+    } else if (world->impl->swapGlViews &&
+               world->state == PUGL_WORLD_EXPOSING) {
+      surface->swapPending = true; // Swapped after all views are drawn
+    } else {
+      puglX11GlSwap(view, surface);
+    }
   }
 
+  surface->age = 0U;
   return glXMakeCurrent(display, None, NULL) ? PUGL_SUCCESS : PUGL_FAILURE;
 }
 
+/**
+   Move a rectangle of the back buffer in bands that don't overlap.
+
+   Copying between overlapping regions of the same buffer is undefined, so the
+   rectangle is copied in bands no larger than the distance it moves, starting
+   with the band that moves furthest into the area that isn't copied from.
+   Coordinates are in GL, so the origin is at the bottom left.
+*/
+static void
+puglX11GlMoveBack(const PuglX11GlCache* const cache,
+                  const PuglRect              src,
+                  const int                   dx,
+                  const int                   dy)
+{
+  const bool vertical = dy != 0;
+  const int  distance = abs(vertical ? dy : dx);
+  const int  length   = vertical ? (int)src.height : (int)src.width;
+  const int  step     = (vertical ? dy : dx) > 0 ? -distance : distance;
+
+  int offset = step < 0 ? ((length - 1) / distance) * distance : 0;
+  for (; offset >= 0 && offset < length; offset += step) {
+    const int size = MIN(distance, length - offset);
+    const int x0   = src.x + (vertical ? 0 : offset);
+    const int y0   = src.y + (vertical ? offset : 0);
+    const int x1   = vertical ? src.x + (int)src.width : x0 + size;
+    const int y1   = vertical ? y0 + size : src.y + (int)src.height;
+
+    cache->blitFramebuffer(x0,
+                           y0,
+                           x1,
+                           y1,
+                           x0 + dx,
+                           y0 + dy,
+                           x1 + dx,
+                           y1 + dy,
+                           GL_COLOR_BUFFER_BIT,
+                           GL_NEAREST);
+  }
+}
+
+static PuglStatus
+puglX11GlScroll(PuglView* const view,
+                const PuglRect  rect,
+                const int       dx,
+                const int       dy)
+{
+  PuglX11GlSurface* const     surface = (PuglX11GlSurface*)view->impl->surface;
+  const PuglX11GlCache* const cache   = puglX11GlGetCache(view->world);
+  Display* const              display = view->world->impl->display;
+  const PuglSpan              height  = view->lastConfigure.height;
+
+  // Only a back buffer that's copied from has the last frame to move
+  if (!surface || !surface->copy) {
+    return puglStubScroll(view, rect, dx, dy);
+  }
+
+  if (!cache->bindFramebuffer || !cache->blitFramebuffer ||
+      surface->copiedSize.width != view->lastConfigure.width ||
+      surface->copiedSize.height != height) {
+    return PUGL_FAILURE;
+  }
+
+  // Enter the context unless the application already has
+  const bool enter = glXGetCurrentContext() != surface->ctx;
+  PuglStatus st    = PUGL_SUCCESS;
+  if (enter && (st = puglX11GlEnter(view, NULL))) {
+    return st;
+  }
+
+  // Framebuffer blits are only available since OpenGL 3.0
+  GLint major = 0;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  if (major < 3) {
+    st = PUGL_UNSUPPORTED;
+  } else {
+    GLint readFramebuffer = 0;
+    GLint drawFramebuffer = 0;
+    GLint readBuffer      = GL_BACK;
+    GLint drawBuffer      = GL_BACK;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+    cache->bindFramebuffer(GL_FRAMEBUFFER, 0U);
+    glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+    glGetIntegerv(GL_DRAW_BUFFER, &drawBuffer);
+
+    const GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    glReadBuffer(GL_BACK);
+    glDrawBuffer(GL_BACK);
+
+    // Move the part that stays visible, which is flipped in GL coordinates
+    const PuglSpan  width = rect.width - (PuglSpan)abs(dx);
+    const PuglSpan  rows  = rect.height - (PuglSpan)abs(dy);
+    const PuglCoord srcX  = (PuglCoord)(rect.x + MAX(-dx, 0));
+    const PuglCoord srcY  = (PuglCoord)(rect.y + MAX(-dy, 0));
+    const PuglCoord glY   = (PuglCoord)((int)height - (srcY + (int)rows));
+    const PuglRect  src   = {srcX, glY, width, rows};
+    puglX11GlMoveBack(cache, src, dx, -dy);
+
+    glReadBuffer((GLenum)readBuffer);
+    glDrawBuffer((GLenum)drawBuffer);
+    if (scissor) {
+      glEnable(GL_SCISSOR_TEST);
+    }
+
+    cache->bindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)readFramebuffer);
+    cache->bindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)drawFramebuffer);
+
+    // Show the moved part, the revealed strips are obscured by the caller
+    cache->copySubBuffer(
+      display, view->impl->win, srcX + dx, glY - dy, (int)width, (int)rows);
+  }
+
+  if (enter) {
+    const PuglStatus st1 = puglX11GlLeave(view, NULL);
+    st                   = st ? st : st1;
+  }
+
+  return st;
+}
+
 static PuglStatus
 puglX11GlCreate(PuglView* view)
 {
-  PuglInternals* const    impl      = view->impl;
-  PuglX11GlSurface* const surface   = (PuglX11GlSurface*)impl->surface;
-  Display* const          display   = view->world->impl->display;
-  GLXFBConfig             fb_config = surface->fb_config;
-  PuglStatus              st        = PUGL_SUCCESS;
+  PuglInternals* const         impl    = view->impl;
+  PuglX11GlSurface* const      surface = (PuglX11GlSurface*)impl->surface;
+  const PuglX11GlConfig* const config  = &surface->config;
+  const PuglX11GlCache* const  cache   = puglX11GlGetCache(view->world);
+  Display* const               display = view->world->impl->display;
+  PuglStatus                   st      = PUGL_SUCCESS;
 
   const int ctx_attrs[] = {
     GLX_CONTEXT_MAJOR_VERSION_ARB,
@@ -152,22 +722,19 @@ puglX11GlCreate(PuglView* view)
             : GLX_CONTEXT_CORE_PROFILE_BIT_ARB)),
     0};
 
-  const char* const extensions =
-    glXQueryExtensionsString(display, view->impl->screen);
+  // Get the context to share resources with, if any
+  const GLXContext share = puglX11GlGetSharedContext(view);
 
   // Try to create a modern context
-  if (!!strstr(extensions, "GLX_ARB_create_context")) {
-    PFNGLXCREATECONTEXTATTRIBSARBPROC create_context =
-      (PFNGLXCREATECONTEXTATTRIBSARBPROC)glXGetProcAddress(
-        (const uint8_t*)"glXCreateContextAttribsARB");
-
-    surface->ctx = create_context(display, fb_config, 0, True, ctx_attrs);
+  if (config->hasCreateContext) {
+    surface->ctx =
+      cache->createContext(display, config->fbConfig, share, True, ctx_attrs);
   }
 
   // If that failed, fall back to the legacy API
   if (!surface->ctx) {
-    surface->ctx =
-      glXCreateNewContext(display, fb_config, GLX_RGBA_TYPE, 0, True);
+    surface->ctx = glXCreateNewContext(
+      display, config->fbConfig, GLX_RGBA_TYPE, share, True);
   }
 
   if (!surface->ctx) {
@@ -175,11 +742,7 @@ puglX11GlCreate(PuglView* view)
   }
 
   // Set up the swap interval
-  if (!!strstr(extensions, "GLX_EXT_swap_control")) {
-    PFNGLXSWAPINTERVALEXTPROC glXSwapIntervalEXT =
-      (PFNGLXSWAPINTERVALEXTPROC)glXGetProcAddress(
-        (const uint8_t*)"glXSwapIntervalEXT");
-
+  if (config->hasSwapControl) {
     // Note that some drivers (NVidia) require the context to be entered here
     if ((st = puglX11GlEnter(view, NULL))) {
       return st;
@@ -187,7 +750,7 @@ puglX11GlCreate(PuglView* view)
 
     // Set the swap interval if the user requested a specific value
     if (view->hints[PUGL_SWAP_INTERVAL] != PUGL_DONT_CARE) {
-      glXSwapIntervalEXT(display, impl->win, view->hints[PUGL_SWAP_INTERVAL]);
+      cache->swapInterval(display, impl->win, view->hints[PUGL_SWAP_INTERVAL]);
     }
 
     // Get the actual current swap interval
@@ -196,17 +759,46 @@ puglX11GlCreate(PuglView* view)
                      GLX_SWAP_INTERVAL_EXT,
                      (unsigned int*)&view->hints[PUGL_SWAP_INTERVAL]);
 
+    surface->interval = view->hints[PUGL_SWAP_INTERVAL];
+
     if ((st = puglX11GlLeave(view, NULL))) {
       return st;
     }
   }
 
-  return !glXGetConfig(display,
-                       impl->vi,
-                       GLX_DOUBLEBUFFER,
-                       &view->hints[PUGL_DOUBLE_BUFFER])
-           ? PUGL_SUCCESS
-           : PUGL_UNKNOWN_ERROR;
+  // Render on another thread only if Xlib was initialized for threads
+  const bool threaded = view->hints[PUGL_RENDER_THREAD] == PUGL_TRUE &&
+                        (view->world->impl->flags & PUGL_WORLD_THREADS);
+
+  view->hints[PUGL_RENDER_THREAD] = threaded ? PUGL_TRUE : PUGL_FALSE;
+
+  // Copy exposed regions instead of swapping to preserve the back buffer
+  surface->copy = view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE &&
+                  view->hints[PUGL_DOUBLE_BUFFER] && !threaded &&
+                  config->hasCopySubBuffer;
+
+  view->hints[PUGL_PRESERVE_CONTENTS] = surface->copy ? PUGL_TRUE : PUGL_FALSE;
+
+  // Report when swaps are shown if they're synchronized to the refresh
+  surface->timing = config->hasSyncControl && view->hints[PUGL_DOUBLE_BUFFER] &&
+                    view->hints[PUGL_SWAP_INTERVAL] >= 1 && !threaded &&
+                    !surface->copy;
+
+  if (surface->timing) {
+    int32_t numerator   = 0;
+    int32_t denominator = 0;
+    if (cache->getMscRate(display, impl->win, &numerator, &denominator) &&
+        numerator > 0 && denominator > 0) {
+      surface->period = (double)denominator / (double)numerator;
+    } else if (view->hints[PUGL_REFRESH_RATE] > 0) {
+      surface->period = 1.0 / (double)view->hints[PUGL_REFRESH_RATE];
+    }
+
+    impl->pollPresents = puglX11GlPollPresents;
+  }
+
+  // The double buffer hint was already set to the actual value when choosing
+  return PUGL_SUCCESS;
 }
 
 static void
@@ -216,7 +808,10 @@ puglX11GlDestroy(PuglView* view)
   if (surface) {
     glXDestroyContext(view->world->impl->display, surface->ctx);
     free(surface);
-    view->impl->surface = NULL;
+    view->impl->surface            = NULL;
+    view->impl->pollPresents       = NULL;
+    view->impl->numPendingPresents = 0U;
+    view->impl->nextPresentTime    = 0.0;
   }
 }
 
@@ -226,6 +821,38 @@ puglGetProcAddress(const char* name)
   return glXGetProcAddress((const uint8_t*)name);
 }
 
+PuglStatus
+puglSwapBuffers(PuglView* const view)
+{
+  const PuglX11GlSurface* const surface =
+    (const PuglX11GlSurface*)view->impl->surface;
+
+  if (!surface || !surface->ctx) {
+    return PUGL_FAILURE;
+  }
+
+  if (view->hints[PUGL_DOUBLE_BUFFER]) {
+    glXSwapBuffers(view->world->impl->display, view->impl->win);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+unsigned
+puglGetBufferAge(const PuglView* const view)
+{
+  const PuglX11GlSurface* const surface =
+    (const PuglX11GlSurface*)view->impl->surface;
+
+  return surface ? surface->age : 0U;
+}
+
+PuglStatus
+puglSetSharedContext(PuglView* const view, PuglView* const other)
+{
+  return puglSetSharedView(view, other);
+}
+
 PuglStatus
 puglEnterContext(PuglView* view)
 {
@@ -246,7 +873,8 @@ puglGlBackend(void)
                                       puglX11GlDestroy,
                                       puglX11GlEnter,
                                       puglX11GlLeave,
-                                      puglStubGetContext};
+                                      puglStubGetContext,
+                                      puglX11GlScroll};
 
   return &backend;
 }
@@ -0,0 +1,395 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "x11_image.h"
+
+#include "macros.h"
+#include "types.h"
+#include "x11.h"
+
+#include <pugl/pugl.h>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#if USE_XSHM
+#  include <X11/Xlib-xcb.h>
+#  include <X11/extensions/XShm.h>
+#  include <sys/ipc.h>
+#  include <sys/shm.h>
+#  include <xcb/shm.h>
+#  include <xcb/xcb.h>
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Return the byte order of 32-bit native-endian pixels
+static int
+puglX11ImageByteOrder(void)
+{
+  const uint16_t one = 1U;
+
+  return *(const uint8_t*)&one ? LSBFirst : MSBFirst;
+}
+
+/// Return true if an image has tightly packed 32-bit pixels
+static bool
+puglX11ImageIsCompatible(const XImage* const ximage, const PuglSpan width)
+{
+  return ximage->bits_per_pixel == 32 &&
+         ximage->bytes_per_line == (int)width * 4;
+}
+
+PuglArea
+puglX11GetViewSize(const PuglView* const view)
+{
+  PuglArea size = {0U, 0U};
+
+  if (view->lastConfigure.type == PUGL_CONFIGURE) {
+    // Use the size of the last configured frame
+    size.width  = view->lastConfigure.width;
+    size.height = view->lastConfigure.height;
+  } else {
+    // Use the default size
+    size.width  = view->sizeHints[PUGL_DEFAULT_SIZE].width;
+    size.height = view->sizeHints[PUGL_DEFAULT_SIZE].height;
+  }
+
+  return size;
+}
+
+bool
+puglX11ImageHasCompatibleVisual(const XVisualInfo* const vi)
+{
+  return (vi->depth == 24 || vi->depth == 32) && vi->red_mask == 0xFF0000UL &&
+         vi->green_mask == 0x00FF00UL && vi->blue_mask == 0x0000FFUL;
+}
+
+bool
+puglX11ImageCanShare(Display* const display)
+{
+#if USE_XSHM
+  return XShmQueryExtension(display);
+#else
+  (void)display;
+  return false;
+#endif
+}
+
+#if USE_XSHM
+
+/**
+   Attach a shared memory segment to the server and check that it worked.
+
+   Attaching fails if the server can't access the segment, for example if
+   it's on another machine.  The attach is made as a checked XCB request, so
+   its error is returned here instead of going to the error handler, and
+   errors from any other requests are handled as usual.
+*/
+static bool
+puglX11AttachSharedImage(Display* const display, XShmSegmentInfo* const shm)
+{
+  xcb_connection_t* const conn = XGetXCBConnection(display);
+  const xcb_shm_seg_t     seg  = xcb_generate_id(conn);
+
+  xcb_generic_error_t* const error = xcb_request_check(
+    conn, xcb_shm_attach_checked(conn, seg, (uint32_t)shm->shmid, 0U));
+
+  if (error) {
+    free(error);
+    return false;
+  }
+
+  shm->shmseg = seg;
+  return true;
+}
+
+static PuglStatus
+puglX11CreateSharedImage(PuglView* const     view,
+                         PuglX11Image* const image,
+                         const PuglSpan      width,
+                         const PuglSpan      height)
+{
+  Display* const           display = view->world->impl->display;
+  const XVisualInfo* const vi      = view->impl->vi;
+  XShmSegmentInfo* const   shm     = &image->shm;
+
+  XImage* const ximage = XShmCreateImage(display,
+                                         vi->visual,
+                                         (unsigned)vi->depth,
+                                         ZPixmap,
+                                         NULL,
+                                         shm,
+                                         width,
+                                         height);
+
+  // Shared images can't be swapped, so the byte order must match too
+  if (!ximage || !puglX11ImageIsCompatible(ximage, width) ||
+      ximage->byte_order != puglX11ImageByteOrder()) {
+    if (ximage) {
+      XDestroyImage(ximage);
+    }
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  // Create and map a new shared memory segment for the image
+  const size_t size = (size_t)ximage->bytes_per_line * height;
+  if ((shm->shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600)) < 0) {
+    XDestroyImage(ximage);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  shm->shmaddr = (char*)shmat(shm->shmid, NULL, 0);
+  if (shm->shmaddr == (char*)-1) {
+    shmctl(shm->shmid, IPC_RMID, NULL);
+    shm->shmaddr = NULL;
+    XDestroyImage(ximage);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  // Attach the segment to the server
+  ximage->data        = shm->shmaddr;
+  shm->readOnly       = False;
+  const bool attached = puglX11AttachSharedImage(display, shm);
+
+  // Mark the segment for removal, so it's freed when both sides detach
+  shmctl(shm->shmid, IPC_RMID, NULL);
+  if (!attached) {
+    shmdt(shm->shmaddr);
+    shm->shmaddr = NULL;
+    XDestroyImage(ximage);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  image->ximage = ximage;
+  return PUGL_SUCCESS;
+}
+
+#endif
+
+PuglStatus
+puglX11CreateImage(PuglView* const     view,
+                   PuglX11Image* const image,
+                   const bool          shared,
+                   const PuglSpan      width,
+                   const PuglSpan      height)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+
+#if USE_XSHM
+  image->shm.shmaddr = NULL;
+  if (shared) {
+    return puglX11CreateSharedImage(view, image, width, height);
+  }
+#else
+  if (shared) {
+    return PUGL_UNSUPPORTED;
+  }
+#endif
+
+  XImage* const ximage = XCreateImage(display,
+                                      impl->vi->visual,
+                                      (unsigned)impl->vi->depth,
+                                      ZPixmap,
+                                      0,
+                                      NULL,
+                                      width,
+                                      height,
+                                      32,
+                                      0);
+
+  if (!ximage || !puglX11ImageIsCompatible(ximage, width)) {
+    if (ximage) {
+      XDestroyImage(ximage);
+    }
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  // Allocate pixels in native byte order, which Xlib converts if necessary
+  const size_t stride = (size_t)ximage->bytes_per_line;
+  if (!(ximage->data = (char*)calloc(height, stride))) {
+    XDestroyImage(ximage);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  ximage->byte_order = puglX11ImageByteOrder();
+  image->ximage      = ximage;
+  return PUGL_SUCCESS;
+}
+
+void
+puglX11DestroyImage(Display* const display, PuglX11Image* const image)
+{
+  if (image->ximage) {
+#if USE_XSHM
+    if (image->shm.shmaddr) {
+      XShmDetach(display, &image->shm);
+      shmdt(image->shm.shmaddr);
+      image->shm.shmaddr = NULL;
+    }
+#else
+    (void)display;
+#endif
+
+    XDestroyImage(image->ximage);
+    image->ximage = NULL;
+  }
+}
+
+/// Put a rectangle of an image to a drawable, returning true if it's shared
+static bool
+puglX11PutImage(PuglView* const           view,
+                const PuglX11Image* const image,
+                const GC                  gc,
+                const Drawable            drawable,
+                const PuglRect            rect)
+{
+  Display* const display = view->world->impl->display;
+
+#if USE_XSHM
+  if (image->shm.shmaddr) {
+    XShmPutImage(display,
+                 drawable,
+                 gc,
+                 image->ximage,
+                 rect.x,
+                 rect.y,
+                 rect.x,
+                 rect.y,
+                 rect.width,
+                 rect.height,
+                 False);
+    return true;
+  }
+#endif
+
+  XPutImage(display,
+            drawable,
+            gc,
+            image->ximage,
+            rect.x,
+            rect.y,
+            rect.x,
+            rect.y,
+            rect.width,
+            rect.height);
+
+  return false;
+}
+
+void
+puglX11FreePresentPixmaps(Display* const               display,
+                          PuglX11PresentPixmaps* const pixmaps)
+{
+  for (size_t i = 0U; i < 2U; ++i) {
+    if (pixmaps->pixmaps[i]) {
+      XFreePixmap(display, pixmaps->pixmaps[i]);
+      pixmaps->pixmaps[i] = None;
+    }
+  }
+}
+
+/**
+   Return a pixmap to put an image to before presenting it.
+
+   This returns a pixmap that the server isn't still presenting if possible,
+   creating the second one only when the first is busy.
+*/
+static Pixmap
+puglX11GetIdlePixmap(PuglView* const              view,
+                     PuglX11PresentPixmaps* const pixmaps,
+                     const PuglSpan               width,
+                     const PuglSpan               height)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+
+  // Replace the pixmaps if the size has changed
+  if (width != pixmaps->width || height != pixmaps->height) {
+    puglX11FreePresentPixmaps(display, pixmaps);
+    pixmaps->width  = width;
+    pixmaps->height = height;
+  }
+
+  for (size_t i = 0U; i < 2U; ++i) {
+    if (!pixmaps->pixmaps[i]) {
+      pixmaps->pixmaps[i] = XCreatePixmap(
+        display, impl->win, width, height, (unsigned)impl->vi->depth);
+    }
+
+    if (!puglX11PixmapIsBusy(view, pixmaps->pixmaps[i])) {
+      return pixmaps->pixmaps[i];
+    }
+  }
+
+  /* Both are busy, which is unlikely since views aren't exposed again until
+     the last frame is shown, so just use the first. */
+  return pixmaps->pixmaps[0];
+}
+
+bool
+puglX11ShowImage(PuglView* const              view,
+                 const PuglX11Image* const    image,
+                 const GC                     gc,
+                 PuglX11PresentPixmaps* const pixmaps,
+                 const PuglRect* const        rects,
+                 const size_t                 numRects)
+{
+  const XImage* const ximage  = image->ximage;
+  bool                pending = false;
+
+  if (pixmaps) {
+    const Pixmap pixmap = puglX11GetIdlePixmap(
+      view, pixmaps, (PuglSpan)ximage->width, (PuglSpan)ximage->height);
+
+    for (size_t i = 0U; i < numRects; ++i) {
+      if (puglX11PutImage(view, image, gc, pixmap, rects[i])) {
+        pending = true;
+      }
+    }
+
+    if (!puglX11PresentPixmap(view, pixmap, rects, numRects)) {
+      return pending;
+    }
+  }
+
+  // Put to the window directly if not presenting, or presenting failed
+  for (size_t i = 0U; i < numRects; ++i) {
+    if (puglX11PutImage(view, image, gc, view->impl->win, rects[i])) {
+      pending = true;
+    }
+  }
+
+  return pending;
+}
+
+void
+puglX11ScrollImage(XImage* const  ximage,
+                   const PuglRect rect,
+                   const int      dx,
+                   const int      dy)
+{
+  const size_t stride = (size_t)ximage->bytes_per_line;
+  const int    srcX   = rect.x + MAX(-dx, 0);
+  const int    srcY   = rect.y + MAX(-dy, 0);
+  const int    width  = (int)rect.width - abs(dx);
+  const int    height = (int)rect.height - abs(dy);
+  const size_t size   = (size_t)width * 4U;
+
+  // Move rows in the opposite direction to the scroll so none are clobbered
+  for (int i = 0; i < height; ++i) {
+    const int   row = dy > 0 ? height - 1 - i : i;
+    char* const src = ximage->data + ((size_t)(srcY + row) * stride) +
+                      ((size_t)srcX * 4U);
+
+    memmove(src + ((ptrdiff_t)dy * (ptrdiff_t)stride) + ((ptrdiff_t)dx * 4),
+            src,
+            size);
+  }
+}
@@ -0,0 +1,105 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef PUGL_SRC_X11_IMAGE_H
+#define PUGL_SRC_X11_IMAGE_H
+
+#include "attributes.h"
+#include "types.h"
+
+#include <pugl/attributes.h>
+#include <pugl/pugl.h>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#ifndef USE_XSHM
+#  if __has_include(<X11/extensions/XShm.h>) && \
+    __has_include(<X11/Xlib-xcb.h>) && __has_include(<xcb/shm.h>)
+#    define USE_XSHM 1
+#  else
+#    define USE_XSHM 0
+#  endif
+#endif
+
+#if USE_XSHM
+#  include <X11/extensions/XShm.h>
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+PUGL_BEGIN_DECLS
+
+/// A client-side image with 32-bit native-endian pixels, for a view's window
+typedef struct {
+  XImage* ximage; ///< Image with pixel data, or null
+#if USE_XSHM
+  XShmSegmentInfo shm; ///< Shared memory segment, if attached to the server
+#endif
+} PuglX11Image;
+
+/// A pair of pixmaps that images are put to for presenting to a window
+typedef struct {
+  Pixmap   pixmaps[2]; ///< Pixmaps, or None
+  PuglSpan width;      ///< Width of pixmaps
+  PuglSpan height;     ///< Height of pixmaps
+} PuglX11PresentPixmaps;
+
+/// Return the size of the last configuration of a view, or its default size
+PUGL_API PuglArea
+puglX11GetViewSize(const PuglView* view);
+
+/// Return true if a visual has 8-bit channels in 32-bit ARGB pixels
+PUGL_API bool
+puglX11ImageHasCompatibleVisual(const XVisualInfo* vi);
+
+/// Return true if shared images are supported by the display
+PUGL_API bool
+puglX11ImageCanShare(Display* display);
+
+/**
+   Create a new zeroed image for a view.
+
+   If `shared` is true, then the image is created in shared memory, and this
+   fails if that isn't possible.
+*/
+PUGL_WARN_UNUSED_RESULT PUGL_API PuglStatus
+puglX11CreateImage(PuglView*     view,
+                   PuglX11Image* image,
+                   bool          shared,
+                   PuglSpan      width,
+                   PuglSpan      height);
+
+/// Destroy an image, detaching it from the server if it's shared
+PUGL_API void
+puglX11DestroyImage(Display* display, PuglX11Image* image);
+
+/// Free the pixmaps used for presenting images
+PUGL_API void
+puglX11FreePresentPixmaps(Display* display, PuglX11PresentPixmaps* pixmaps);
+
+/**
+   Show rectangles of an image in the view's window.
+
+   If `pixmaps` isn't null, then the image is put to one of them which is
+   presented at the next refresh, otherwise it's put to the window directly.
+   A shared image is read by the server asynchronously, so if this returns
+   true, the caller must sync with the server before modifying the image.
+*/
+PUGL_API bool
+puglX11ShowImage(PuglView*              view,
+                 const PuglX11Image*    image,
+                 GC                     gc,
+                 PuglX11PresentPixmaps* pixmaps,
+                 const PuglRect*        rects,
+                 size_t                 numRects);
+
+/// Move the pixels within a rectangle of an image by an offset
+PUGL_API void
+puglX11ScrollImage(XImage* ximage, PuglRect rect, int dx, int dy);
+
+PUGL_END_DECLS
+
+#endif // PUGL_SRC_X11_IMAGE_H
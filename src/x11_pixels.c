@@ -0,0 +1,272 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "macros.h"
+#include "types.h"
+#include "x11.h"
+#include "x11_image.h"
+
+#include <pugl/pixels.h>
+#include <pugl/pugl.h>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  PuglX11Image          image;   ///< Image that contains the pixel buffer
+  PuglPixels            pixels;  ///< Description of the pixel buffer
+  PuglX11PresentPixmaps pixmaps; ///< Pixmaps for presenting the image
+  GC                    gc;      ///< Graphics context for putting images
+  bool                  shared;  ///< True if images are in shared memory
+  bool                  present; ///< True if frames are shown at the refresh
+  bool                  drawing; ///< True while handling an expose
+  bool                  pending; ///< True if a shared image put is in progress
+} PuglX11PixelsSurface;
+
+static PuglStatus
+puglX11PixelsConfigure(PuglView* view)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+  XVisualInfo          pat     = {0};
+  int                  n       = 0;
+
+  // Find a visual with the same pixel layout as the buffer
+  pat.screen     = impl->screen;
+  pat.depth      = 24;
+  pat.class      = TrueColor;
+  pat.red_mask   = 0xFF0000UL;
+  pat.green_mask = 0x00FF00UL;
+  pat.blue_mask  = 0x0000FFUL;
+
+  const long mask = VisualScreenMask | VisualDepthMask | VisualClassMask |
+                    VisualRedMaskMask | VisualGreenMaskMask |
+                    VisualBlueMaskMask;
+
+  if (!(impl->vi = XGetVisualInfo(display, mask, &pat, &n))) {
+    return PUGL_BAD_CONFIGURATION;
+  }
+
+  view->hints[PUGL_RED_BITS]   = 8;
+  view->hints[PUGL_GREEN_BITS] = 8;
+  view->hints[PUGL_BLUE_BITS]  = 8;
+  view->hints[PUGL_ALPHA_BITS] = 0;
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglX11PixelsCreate(PuglView* view)
+{
+  PuglInternals* const impl    = view->impl;
+  Display* const       display = view->world->impl->display;
+
+  PuglX11PixelsSurface* const surface =
+    (PuglX11PixelsSurface*)calloc(1, sizeof(PuglX11PixelsSurface));
+
+  if (!surface) {
+    return PUGL_NO_MEMORY;
+  }
+
+  // Use shared memory if possible, unless a plain image is requested
+  surface->shared = view->hints[PUGL_SURFACE_TYPE] != PUGL_IMAGE_SURFACE &&
+                    puglX11ImageCanShare(display);
+
+  view->hints[PUGL_SURFACE_TYPE] =
+    surface->shared ? PUGL_SHARED_IMAGE_SURFACE : PUGL_IMAGE_SURFACE;
+
+  // Present frames at the refresh if a swap interval is requested
+  surface->present = view->hints[PUGL_SWAP_INTERVAL] >= 1 &&
+                     puglX11CanPresent(view);
+
+  view->hints[PUGL_SWAP_INTERVAL] = surface->present ? 1 : 0;
+
+  surface->gc   = XCreateGC(display, impl->win, 0, NULL);
+  impl->surface = surface;
+  return PUGL_SUCCESS;
+}
+
+static void
+puglX11PixelsDestroy(PuglView* view)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+  Display* const              display = view->world->impl->display;
+
+  if (surface) {
+    puglX11DestroyImage(display, &surface->image);
+    puglX11FreePresentPixmaps(display, &surface->pixmaps);
+    XFreeGC(display, surface->gc);
+    free(surface);
+    impl->surface = NULL;
+  }
+}
+
+static PuglStatus
+puglX11PixelsOpen(PuglView* const view,
+                  const PuglSpan  width,
+                  const PuglSpan  height)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+  Display* const              display = view->world->impl->display;
+  PuglPixels* const           pixels  = &surface->pixels;
+
+  // Reuse the image from previous exposes if the size hasn't changed
+  if (surface->image.ximage && width == pixels->width &&
+      height == pixels->height) {
+    return PUGL_SUCCESS;
+  }
+
+  // Create a new image, falling back to a plain one if sharing fails
+  PuglX11Image image = {NULL};
+  PuglStatus   st    = PUGL_SUCCESS;
+  if (surface->shared &&
+      (st = puglX11CreateImage(view, &image, true, width, height))) {
+    surface->shared                = false;
+    view->hints[PUGL_SURFACE_TYPE] = PUGL_IMAGE_SURFACE;
+  }
+
+  if (!surface->shared &&
+      (st = puglX11CreateImage(view, &image, false, width, height))) {
+    return st;
+  }
+
+  // Copy the previous contents to the new image if they're preserved
+  const size_t stride = (size_t)image.ximage->bytes_per_line;
+  if (surface->image.ximage &&
+      view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE) {
+    const PuglSpan copyWidth  = MIN(width, pixels->width);
+    const PuglSpan copyHeight = MIN(height, pixels->height);
+    for (PuglSpan y = 0U; y < copyHeight; ++y) {
+      memcpy(image.ximage->data + (y * stride),
+             surface->image.ximage->data + (y * pixels->stride),
+             (size_t)copyWidth * 4U);
+    }
+  }
+
+  // Replace the old image
+  puglX11DestroyImage(display, &surface->image);
+  surface->image = image;
+  pixels->data   = image.ximage->data;
+  pixels->stride = stride;
+  pixels->width  = width;
+  pixels->height = height;
+  pixels->format = PUGL_PIXEL_FORMAT_XRGB32;
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglX11PixelsEnter(PuglView* view, const PuglExposeEvent* expose)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+  PuglStatus                  st      = PUGL_SUCCESS;
+
+  if (expose) {
+    // Wait until the server has finished reading the last shared image
+    if (surface->pending) {
+      XSync(view->world->impl->display, False);
+      surface->pending = false;
+    }
+
+    const PuglArea viewSize = puglX11GetViewSize(view);
+    const PuglSpan right    = (PuglSpan)(expose->x + expose->width);
+    const PuglSpan bottom   = (PuglSpan)(expose->y + expose->height);
+    const PuglSpan width    = MAX(right, viewSize.width);
+    const PuglSpan height   = MAX(bottom, viewSize.height);
+    if (!(st = puglX11PixelsOpen(view, width, height))) {
+      surface->drawing = true;
+    }
+  }
+
+  return st;
+}
+
+static PuglStatus
+puglX11PixelsLeave(PuglView* view, const PuglExposeEvent* expose)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+
+  if (expose && surface->drawing) {
+    const PuglRect bounds = {
+      expose->x, expose->y, expose->width, expose->height};
+
+    const bool      hasRects = view->numExposeRects > 0U;
+    const PuglRect* rects    = hasRects ? view->exposeRects : &bounds;
+    const size_t    numRects = hasRects ? view->numExposeRects : 1U;
+
+    // Show only the exposed region of the image
+    if (puglX11ShowImage(view,
+                         &surface->image,
+                         surface->gc,
+                         surface->present ? &surface->pixmaps : NULL,
+                         rects,
+                         numRects)) {
+      surface->pending = true;
+    }
+
+    surface->drawing = false;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglX11PixelsScroll(PuglView* const view,
+                    const PuglRect  rect,
+                    const int       dx,
+                    const int       dy)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+  const PuglPixels* const     pixels  = &surface->pixels;
+
+  // Move the contents of the buffer too if they're preserved
+  if (view->hints[PUGL_PRESERVE_CONTENTS] == PUGL_TRUE &&
+      surface->image.ximage) {
+    if (rect.x + rect.width > (int)pixels->width ||
+        rect.y + rect.height > (int)pixels->height) {
+      return PUGL_FAILURE;
+    }
+
+    if (surface->pending) {
+      XSync(view->world->impl->display, False);
+      surface->pending = false;
+    }
+
+    puglX11ScrollImage(surface->image.ximage, rect, dx, dy);
+  }
+
+  return puglX11ScrollWindow(view, rect, dx, dy);
+}
+
+static void*
+puglX11PixelsGetContext(PuglView* view)
+{
+  PuglInternals* const        impl    = view->impl;
+  PuglX11PixelsSurface* const surface = (PuglX11PixelsSurface*)impl->surface;
+
+  return (surface && surface->drawing) ? &surface->pixels : NULL;
+}
+
+const PuglBackend*
+puglPixelsBackend(void)
+{
+  static const PuglBackend backend = {puglX11PixelsConfigure,
+                                      puglX11PixelsCreate,
+                                      puglX11PixelsDestroy,
+                                      puglX11PixelsEnter,
+                                      puglX11PixelsLeave,
+                                      puglX11PixelsGetContext,
+                                      puglX11PixelsScroll};
+
+  return &backend;
+}
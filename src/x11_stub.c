@@ -19,6 +19,7 @@ puglStubBackend(void)
     puglStubEnter,
     puglStubLeave,
     puglStubGetContext,
+    puglX11ScrollWindow,
   };
 
   return &backend;
@@ -1,9 +1,11 @@
-// Copyright 2012-2022 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #define VK_NO_PROTOTYPES 1
 
 #include "attributes.h"
+#include "internal.h"
+#include "macros.h"
 #include "stub.h"
 #include "types.h"
 #include "x11.h"
@@ -16,9 +18,62 @@
 
 #include <dlfcn.h>
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+/// Number of past presentation timings to read at once
+#define PUGL_VULKAN_MAX_TIMINGS 8U
+
+/// Vulkan functions used to manage a swapchain
+typedef struct {
+  PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR getSurfaceCapabilities;
+  PFN_vkGetPhysicalDeviceSurfaceFormatsKHR      getSurfaceFormats;
+  PFN_vkGetPhysicalDeviceSurfacePresentModesKHR getSurfacePresentModes;
+  PFN_vkCreateSwapchainKHR                      createSwapchain;
+  PFN_vkDestroySwapchainKHR                     destroySwapchain;
+  PFN_vkGetSwapchainImagesKHR                   getSwapchainImages;
+  PFN_vkAcquireNextImageKHR                     acquireNextImage;
+  PFN_vkQueuePresentKHR                         queuePresent;
+  PFN_vkCreateImageView                         createImageView;
+  PFN_vkDestroyImageView                        destroyImageView;
+  PFN_vkCreateSemaphore                         createSemaphore;
+  PFN_vkDestroySemaphore                        destroySemaphore;
+  PFN_vkCreateFence                             createFence;
+  PFN_vkDestroyFence                            destroyFence;
+  PFN_vkWaitForFences                           waitForFences;
+  PFN_vkResetFences                             resetFences;
+  PFN_vkDeviceWaitIdle                          deviceWaitIdle;
+  PFN_vkWaitForPresentKHR                       waitForPresent;
+  PFN_vkGetPastPresentationTimingGOOGLE         getPastPresentationTiming;
+} PuglX11VulkanFuncs;
+
+/// A swapchain managed by Pugl, and everything that depends on it
+typedef struct {
+  PuglX11VulkanFuncs         vk;         ///< Loaded Vulkan functions
+  PuglVulkanSwapchainOptions options;    ///< Options from the application
+  VkSwapchainKHR             swapchain;  ///< Current swapchain, or null
+  VkImage*                   images;     ///< Swapchain images
+  VkImageView*               imageViews; ///< View of each image
+  VkSemaphore*               rendered;   ///< Drawing finished for each image
+  PuglVulkanFrame            frame;      ///< Current frame for the application
+  PuglArea                   size;       ///< View size of the swapchain
+  uint32_t                   numImages;  ///< Number of swapchain images
+  uint32_t                   frameIndex; ///< Index of the next frame in flight
+  PuglVulkanSwapchainFlags   timing;     ///< Method used to report frames
+  uint32_t                   serial;     ///< Serial of the last presented frame
+  uint32_t                   shown;      ///< Serial of the last shown frame
+  bool                       outdated;   ///< True if it must be recreated
+  bool                       drawing;    ///< True while handling an expose
+
+  /// Signaled when the image of each frame in flight is acquired
+  VkSemaphore acquired[PUGL_VULKAN_MAX_FRAMES];
+
+  /// Signaled when each frame in flight is finished
+  VkFence fences[PUGL_VULKAN_MAX_FRAMES];
+} PuglX11VulkanSurface;
+
 struct PuglVulkanLoaderImpl {
   void*                     libvulkan;
   PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
@@ -75,15 +130,705 @@ puglGetDeviceProcAddrFunc(const PuglVulkanLoader* loader)
   return loader ? loader->vkGetDeviceProcAddr : NULL;
 }
 
+/// Load the functions needed to manage a swapchain, returning true if all are
+static bool
+puglX11VulkanLoadFuncs(PFN_vkGetInstanceProcAddr getInstanceProcAddr,
+                       const VkInstance          instance,
+                       const VkDevice            device,
+                       PuglX11VulkanFuncs* const vk)
+{
+  const PFN_vkGetDeviceProcAddr getDeviceProcAddr =
+    (PFN_vkGetDeviceProcAddr)getInstanceProcAddr(instance,
+                                                 "vkGetDeviceProcAddr");
+  if (!getDeviceProcAddr) {
+    return false;
+  }
+
+  vk->getSurfaceCapabilities =
+    (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)getInstanceProcAddr(
+      instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
+  vk->getSurfaceFormats =
+    (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)getInstanceProcAddr(
+      instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+  vk->getSurfacePresentModes =
+    (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)getInstanceProcAddr(
+      instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+
+  vk->createSwapchain = (PFN_vkCreateSwapchainKHR)getDeviceProcAddr(
+    device, "vkCreateSwapchainKHR");
+  vk->destroySwapchain = (PFN_vkDestroySwapchainKHR)getDeviceProcAddr(
+    device, "vkDestroySwapchainKHR");
+  vk->getSwapchainImages = (PFN_vkGetSwapchainImagesKHR)getDeviceProcAddr(
+    device, "vkGetSwapchainImagesKHR");
+  vk->acquireNextImage = (PFN_vkAcquireNextImageKHR)getDeviceProcAddr(
+    device, "vkAcquireNextImageKHR");
+  vk->queuePresent =
+    (PFN_vkQueuePresentKHR)getDeviceProcAddr(device, "vkQueuePresentKHR");
+  vk->createImageView =
+    (PFN_vkCreateImageView)getDeviceProcAddr(device, "vkCreateImageView");
+  vk->destroyImageView =
+    (PFN_vkDestroyImageView)getDeviceProcAddr(device, "vkDestroyImageView");
+  vk->createSemaphore =
+    (PFN_vkCreateSemaphore)getDeviceProcAddr(device, "vkCreateSemaphore");
+  vk->destroySemaphore =
+    (PFN_vkDestroySemaphore)getDeviceProcAddr(device, "vkDestroySemaphore");
+  vk->createFence =
+    (PFN_vkCreateFence)getDeviceProcAddr(device, "vkCreateFence");
+  vk->destroyFence =
+    (PFN_vkDestroyFence)getDeviceProcAddr(device, "vkDestroyFence");
+  vk->waitForFences =
+    (PFN_vkWaitForFences)getDeviceProcAddr(device, "vkWaitForFences");
+  vk->resetFences =
+    (PFN_vkResetFences)getDeviceProcAddr(device, "vkResetFences");
+  vk->deviceWaitIdle =
+    (PFN_vkDeviceWaitIdle)getDeviceProcAddr(device, "vkDeviceWaitIdle");
+
+  // Optional functions for presentation timing
+  vk->waitForPresent = (PFN_vkWaitForPresentKHR)getDeviceProcAddr(
+    device, "vkWaitForPresentKHR");
+  vk->getPastPresentationTiming =
+    (PFN_vkGetPastPresentationTimingGOOGLE)getDeviceProcAddr(
+      device, "vkGetPastPresentationTimingGOOGLE");
+
+  return vk->getSurfaceCapabilities && vk->getSurfaceFormats &&
+         vk->getSurfacePresentModes && vk->createSwapchain &&
+         vk->destroySwapchain && vk->getSwapchainImages &&
+         vk->acquireNextImage && vk->queuePresent && vk->createImageView &&
+         vk->destroyImageView && vk->createSemaphore &&
+         vk->destroySemaphore && vk->createFence && vk->destroyFence &&
+         vk->waitForFences && vk->resetFences && vk->deviceWaitIdle;
+}
+
+/// Set the serial of the last frame that was shown (or will never be)
+static void
+puglX11VulkanSetShown(PuglView* const             view,
+                      PuglX11VulkanSurface* const surface,
+                      const uint32_t              serial)
+{
+  if (surface->timing) {
+    view->impl->numPendingPresents -= serial - surface->shown;
+    surface->shown = serial;
+  }
+}
+
+/// Destroy the swapchain and the objects for each of its images
+static void
+puglX11VulkanDestroySwapchain(PuglX11VulkanSurface* const surface)
+{
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+
+  for (uint32_t i = 0U; i < surface->numImages; ++i) {
+    vk->destroyImageView(opts->device, surface->imageViews[i], opts->allocator);
+    vk->destroySemaphore(opts->device, surface->rendered[i], opts->allocator);
+  }
+
+  if (surface->swapchain) {
+    vk->destroySwapchain(opts->device, surface->swapchain, opts->allocator);
+  }
+
+  free(surface->rendered);
+  free(surface->imageViews);
+  free(surface->images);
+  surface->swapchain  = VK_NULL_HANDLE;
+  surface->images     = NULL;
+  surface->imageViews = NULL;
+  surface->rendered   = NULL;
+  surface->numImages  = 0U;
+}
+
+/// Free the managed swapchain of a view and everything it uses, if any
+static void
+puglX11VulkanFreeSurface(PuglView* const view)
+{
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)view->impl->surface;
+
+  if (surface) {
+    const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+    const PuglVulkanSwapchainOptions* const opts = &surface->options;
+
+    vk->deviceWaitIdle(opts->device);
+    puglX11VulkanSetShown(view, surface, surface->serial);
+    puglX11VulkanDestroySwapchain(surface);
+    for (uint32_t i = 0U; i < opts->numFrames; ++i) {
+      vk->destroySemaphore(opts->device, surface->acquired[i], opts->allocator);
+      vk->destroyFence(opts->device, surface->fences[i], opts->allocator);
+    }
+
+    free(surface);
+    view->impl->surface            = NULL;
+    view->impl->pollPresents       = NULL;
+    view->impl->numPendingPresents = 0U;
+  }
+}
+
+/// Choose the preferred surface format if it's supported, or the first
+static VkResult
+puglX11VulkanChooseFormat(const PuglX11VulkanSurface* const surface,
+                          VkSurfaceFormatKHR* const         format)
+{
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+  VkResult                                vr   = VK_SUCCESS;
+
+  uint32_t n = 0U;
+  if ((vr = vk->getSurfaceFormats(
+         opts->physicalDevice, opts->surface, &n, NULL)) ||
+      !n) {
+    return vr ? vr : VK_ERROR_FORMAT_NOT_SUPPORTED;
+  }
+
+  VkSurfaceFormatKHR* const formats =
+    (VkSurfaceFormatKHR*)calloc(n, sizeof(VkSurfaceFormatKHR));
+  if (!formats) {
+    return VK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  if (!(vr = vk->getSurfaceFormats(
+          opts->physicalDevice, opts->surface, &n, formats))) {
+    *format = formats[0];
+    for (uint32_t i = 0U; i < n; ++i) {
+      if (formats[i].format == opts->format) {
+        *format = formats[i];
+        break;
+      }
+    }
+  }
+
+  free(formats);
+  return vr;
+}
+
+/// Return the preferred present mode if it's supported, or FIFO otherwise
+static VkPresentModeKHR
+puglX11VulkanChoosePresentMode(const PuglX11VulkanSurface* const surface)
+{
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+  VkPresentModeKHR                        mode = VK_PRESENT_MODE_FIFO_KHR;
+
+  uint32_t n = 0U;
+  if (vk->getSurfacePresentModes(
+        opts->physicalDevice, opts->surface, &n, NULL) ||
+      !n) {
+    return mode;
+  }
+
+  VkPresentModeKHR* const modes =
+    (VkPresentModeKHR*)calloc(n, sizeof(VkPresentModeKHR));
+
+  if (modes && !vk->getSurfacePresentModes(
+                 opts->physicalDevice, opts->surface, &n, modes)) {
+    for (uint32_t i = 0U; i < n; ++i) {
+      if (modes[i] == opts->presentMode) {
+        mode = modes[i];
+        break;
+      }
+    }
+  }
+
+  free(modes);
+  return mode;
+}
+
+/// Create the objects for each image of a new swapchain
+static VkResult
+puglX11VulkanCreateImages(PuglX11VulkanSurface* const surface,
+                          const VkFormat              format)
+{
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+  VkResult                                vr   = VK_SUCCESS;
+
+  uint32_t n = 0U;
+  if ((vr = vk->getSwapchainImages(
+         opts->device, surface->swapchain, &n, NULL))) {
+    return vr;
+  }
+
+  surface->images     = (VkImage*)calloc(n, sizeof(VkImage));
+  surface->imageViews = (VkImageView*)calloc(n, sizeof(VkImageView));
+  surface->rendered   = (VkSemaphore*)calloc(n, sizeof(VkSemaphore));
+  if (!surface->images || !surface->imageViews || !surface->rendered) {
+    return VK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  surface->numImages = n;
+  if ((vr = vk->getSwapchainImages(
+         opts->device, surface->swapchain, &n, surface->images))) {
+    return vr;
+  }
+
+  const VkSemaphoreCreateInfo semaphoreInfo = {
+    VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, NULL, 0U};
+
+  for (uint32_t i = 0U; i < n; ++i) {
+    const VkImageViewCreateInfo viewInfo = {
+      VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+      NULL,
+      0U,
+      surface->images[i],
+      VK_IMAGE_VIEW_TYPE_2D,
+      format,
+      {VK_COMPONENT_SWIZZLE_IDENTITY,
+       VK_COMPONENT_SWIZZLE_IDENTITY,
+       VK_COMPONENT_SWIZZLE_IDENTITY,
+       VK_COMPONENT_SWIZZLE_IDENTITY},
+      {VK_IMAGE_ASPECT_COLOR_BIT, 0U, 1U, 0U, 1U},
+    };
+
+    if ((vr = vk->createImageView(opts->device,
+                                  &viewInfo,
+                                  opts->allocator,
+                                  &surface->imageViews[i])) ||
+        (vr = vk->createSemaphore(opts->device,
+                                  &semaphoreInfo,
+                                  opts->allocator,
+                                  &surface->rendered[i]))) {
+      return vr;
+    }
+  }
+
+  return VK_SUCCESS;
+}
+
+/// Create or recreate the swapchain for the current size of the view
+static VkResult
+puglX11VulkanCreateSwapchain(PuglView* const             view,
+                             PuglX11VulkanSurface* const surface)
+{
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+  const PuglConfigureEvent* const         conf = &view->impl->configuration;
+  VkResult                                vr   = VK_SUCCESS;
+
+  // Wait until the old swapchain is no longer in use
+  vk->deviceWaitIdle(opts->device);
+
+  VkSurfaceCapabilitiesKHR caps;
+  if ((vr = vk->getSurfaceCapabilities(
+         opts->physicalDevice, opts->surface, &caps))) {
+    return vr;
+  }
+
+  // Use the size of the surface, or of the view if that's undefined
+  VkExtent2D extent = caps.currentExtent;
+  if (extent.width == UINT32_MAX) {
+    extent.width = MAX(caps.minImageExtent.width,
+                       MIN((uint32_t)conf->width, caps.maxImageExtent.width));
+    extent.height =
+      MAX(caps.minImageExtent.height,
+          MIN((uint32_t)conf->height, caps.maxImageExtent.height));
+  }
+
+  surface->size.width  = conf->width;
+  surface->size.height = conf->height;
+  surface->outdated    = false;
+
+  // Frames presented to the old swapchain will never be reported
+  puglX11VulkanSetShown(view, surface, surface->serial);
+
+  // Have no swapchain at all while the surface is empty (like if minimized)
+  if (!extent.width || !extent.height) {
+    puglX11VulkanDestroySwapchain(surface);
+    return VK_SUCCESS;
+  }
+
+  VkSurfaceFormatKHR format = {VK_FORMAT_UNDEFINED,
+                               VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+  if ((vr = puglX11VulkanChooseFormat(surface, &format))) {
+    return vr;
+  }
+
+  // Use one more image than the minimum so acquiring rarely waits
+  uint32_t numImages = caps.minImageCount + 1U;
+  if (caps.maxImageCount && numImages > caps.maxImageCount) {
+    numImages = caps.maxImageCount;
+  }
+
+  // Use opaque composition if possible, or the first supported mode
+  const VkCompositeAlphaFlagsKHR alphas = caps.supportedCompositeAlpha;
+  const VkCompositeAlphaFlagBitsKHR alpha =
+    (alphas & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR)
+      ? VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR
+      : (VkCompositeAlphaFlagBitsKHR)(alphas & (~alphas + 1U));
+
+  const VkPresentModeKHR presentMode = puglX11VulkanChoosePresentMode(surface);
+
+  const VkSwapchainCreateInfoKHR info = {
+    VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+    NULL,
+    0U,
+    opts->surface,
+    numImages,
+    format.format,
+    format.colorSpace,
+    extent,
+    1U,
+    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | opts->usage,
+    VK_SHARING_MODE_EXCLUSIVE,
+    0U,
+    NULL,
+    caps.currentTransform,
+    alpha,
+    presentMode,
+    VK_TRUE,
+    surface->swapchain,
+  };
+
+  // Create the new swapchain, then replace the old one with it
+  VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+  if ((vr = vk->createSwapchain(
+         opts->device, &info, opts->allocator, &swapchain))) {
+    return vr;
+  }
+
+  puglX11VulkanDestroySwapchain(surface);
+  surface->swapchain = swapchain;
+  if ((vr = puglX11VulkanCreateImages(surface, format.format))) {
+    return vr;
+  }
+
+  surface->frame.format      = format.format;
+  surface->frame.extent      = extent;
+  surface->frame.presentMode = presentMode;
+  surface->frame.numImages   = surface->numImages;
+  surface->frame.recreated   = true;
+  return VK_SUCCESS;
+}
+
+/// Acquire the next image to draw the current frame to
+static VkResult
+puglX11VulkanAcquire(const PuglX11VulkanSurface* const surface,
+                     uint32_t* const                   imageIndex)
+{
+  return surface->vk.acquireNextImage(surface->options.device,
+                                      surface->swapchain,
+                                      UINT64_MAX,
+                                      surface->acquired[surface->frameIndex],
+                                      VK_NULL_HANDLE,
+                                      imageIndex);
+}
+
+static void
+puglX11VulkanDestroy(PuglView* const view)
+{
+  puglX11VulkanFreeSurface(view);
+}
+
+static PuglStatus
+puglX11VulkanEnter(PuglView* const view, const PuglExposeEvent* const expose)
+{
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)view->impl->surface;
+
+  if (!expose || !surface) {
+    return PUGL_SUCCESS;
+  }
+
+  const PuglX11VulkanFuncs* const vk     = &surface->vk;
+  const VkDevice                  device = surface->options.device;
+  const uint32_t                  f      = surface->frameIndex;
+  const PuglConfigureEvent* const conf   = &view->impl->configuration;
+  PuglVulkanFrame* const          frame  = &surface->frame;
+
+  // Recreate the swapchain if it's out of date or the view has been resized
+  if (surface->outdated || conf->width != surface->size.width ||
+      conf->height != surface->size.height) {
+    if (puglX11VulkanCreateSwapchain(view, surface)) {
+      return PUGL_CREATE_CONTEXT_FAILED;
+    }
+  }
+
+  if (!surface->swapchain) {
+    return PUGL_SUCCESS; // Nothing to draw to, so expose without a frame
+  }
+
+  // Wait until the previous use of this frame is finished
+  vk->waitForFences(device, 1U, &surface->fences[f], VK_TRUE, UINT64_MAX);
+
+  // Acquire an image, recreating the swapchain once if it's out of date
+  uint32_t imageIndex = 0U;
+  VkResult vr         = puglX11VulkanAcquire(surface, &imageIndex);
+  if (vr == VK_ERROR_OUT_OF_DATE_KHR) {
+    if (puglX11VulkanCreateSwapchain(view, surface)) {
+      return PUGL_CREATE_CONTEXT_FAILED;
+    }
+
+    if (!surface->swapchain) {
+      return PUGL_SUCCESS;
+    }
+
+    vr = puglX11VulkanAcquire(surface, &imageIndex);
+  }
+
+  if (vr == VK_SUBOPTIMAL_KHR) {
+    surface->outdated = true; // Draw this frame, but recreate for the next
+  } else if (vr) {
+    return PUGL_FAILURE;
+  }
+
+  vk->resetFences(device, 1U, &surface->fences[f]);
+
+  frame->image      = surface->images[imageIndex];
+  frame->imageView  = surface->imageViews[imageIndex];
+  frame->imageIndex = imageIndex;
+  frame->frameIndex = f;
+  frame->serial     = surface->serial + 1U;
+  frame->acquired   = surface->acquired[f];
+  frame->rendered   = surface->rendered[imageIndex];
+  frame->fence      = surface->fences[f];
+  surface->drawing  = true;
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+puglX11VulkanLeave(PuglView* const view, const PuglExposeEvent* const expose)
+{
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)view->impl->surface;
+
+  if (!expose || !surface || !surface->drawing) {
+    return PUGL_SUCCESS;
+  }
+
+  // Set the ID of the frame to be reported when it's shown
+  const PuglVulkanFrame* const frame     = &surface->frame;
+  const uint64_t               presentId = frame->serial;
+  const VkPresentIdKHR         idInfo    = {
+    VK_STRUCTURE_TYPE_PRESENT_ID_KHR, NULL, 1U, &presentId};
+
+  const VkPresentTimeGOOGLE      time      = {frame->serial, 0U};
+  const VkPresentTimesInfoGOOGLE timesInfo = {
+    VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE, NULL, 1U, &time};
+
+  const void* const next =
+    (surface->timing == PUGL_VULKAN_PRESENT_WAIT)     ? (const void*)&idInfo
+    : (surface->timing == PUGL_VULKAN_DISPLAY_TIMING) ? (const void*)&timesInfo
+                                                      : NULL;
+
+  // Present the image once drawing is finished
+  const VkPresentInfoKHR info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+                                 next,
+                                 1U,
+                                 &frame->rendered,
+                                 1U,
+                                 &surface->swapchain,
+                                 &frame->imageIndex,
+                                 NULL};
+
+  const VkResult vr =
+    surface->vk.queuePresent(surface->options.presentQueue, &info);
+
+  surface->outdated =
+    vr == VK_ERROR_OUT_OF_DATE_KHR || vr == VK_SUBOPTIMAL_KHR;
+
+  // Wait for the frame to be shown, unless it wasn't presented at all
+  surface->serial = frame->serial;
+  if (surface->timing) {
+    ++view->impl->numPendingPresents;
+    if (vr && vr != VK_SUBOPTIMAL_KHR) {
+      puglX11VulkanSetShown(view, surface, surface->serial);
+    }
+  }
+
+  // Move on to the next frame in flight
+  const uint32_t numFrames = surface->options.numFrames;
+  surface->frameIndex      = (surface->frameIndex + 1U) % numFrames;
+  surface->frame.recreated = false;
+  surface->drawing         = false;
+  return (vr && !surface->outdated) ? PUGL_FAILURE : PUGL_SUCCESS;
+}
+
+/// Dispatch a present event for a frame that has been shown
+static PuglStatus
+puglX11VulkanDispatchShown(PuglView* const view,
+                           const uint32_t  serial,
+                           const double    time)
+{
+  PuglEvent event      = {{PUGL_PRESENT, 0U}};
+  event.present.kind   = PUGL_PRESENT_COMPLETE;
+  event.present.serial = serial;
+  event.present.time   = time;
+  return puglDispatchEvent(view, &event);
+}
+
+/// Report frames that have been shown using VK_KHR_present_wait
+static PuglStatus
+puglX11VulkanPollPresentWait(PuglView* const             view,
+                             PuglX11VulkanSurface* const surface)
+{
+  PuglStatus st = PUGL_SUCCESS;
+
+  while (!st && surface->shown < surface->serial) {
+    const uint32_t serial = surface->shown + 1U;
+    const VkResult vr     = surface->vk.waitForPresent(
+      surface->options.device, surface->swapchain, serial, 0U);
+
+    if (vr == VK_TIMEOUT) {
+      break;
+    }
+
+    // This provides no timestamp, so use the time it was noticed
+    puglX11VulkanSetShown(view, surface, serial);
+    if (vr == VK_SUCCESS || vr == VK_SUBOPTIMAL_KHR) {
+      st = puglX11VulkanDispatchShown(view, serial, puglGetTime(view->world));
+    }
+  }
+
+  return st;
+}
+
+/// Report frames that have been shown using VK_GOOGLE_display_timing
+static PuglStatus
+puglX11VulkanPollDisplayTiming(PuglView* const             view,
+                               PuglX11VulkanSurface* const surface)
+{
+  VkPastPresentationTimingGOOGLE timings[PUGL_VULKAN_MAX_TIMINGS];
+  PuglStatus                     st = PUGL_SUCCESS;
+  VkResult                       vr = VK_INCOMPLETE;
+
+  while (!st && vr == VK_INCOMPLETE && surface->shown < surface->serial) {
+    uint32_t n = PUGL_VULKAN_MAX_TIMINGS;
+    vr         = surface->vk.getPastPresentationTiming(
+      surface->options.device, surface->swapchain, &n, timings);
+    if (vr && vr != VK_INCOMPLETE) {
+      break;
+    }
+
+    // The actual present time is in nanoseconds on the monotonic clock
+    for (uint32_t i = 0U; !st && i < n; ++i) {
+      const uint32_t serial = timings[i].presentID;
+      if (serial > surface->shown && serial <= surface->serial) {
+        const double t = ((double)timings[i].actualPresentTime / 1e9) -
+                         view->world->startTime;
+
+        puglX11VulkanSetShown(view, surface, serial);
+        st = puglX11VulkanDispatchShown(view, serial, t);
+      }
+    }
+  }
+
+  return st;
+}
+
+/// Report frames of a view with a timed swapchain that have been shown
+static PuglStatus
+puglX11VulkanPollPresents(PuglView* const view)
+{
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)view->impl->surface;
+
+  return (surface->timing == PUGL_VULKAN_PRESENT_WAIT)
+           ? puglX11VulkanPollPresentWait(view, surface)
+           : puglX11VulkanPollDisplayTiming(view, surface);
+}
+
+static void*
+puglX11VulkanGetContext(PuglView* const view)
+{
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)view->impl->surface;
+
+  return (surface && surface->drawing) ? &surface->frame : NULL;
+}
+
+PuglStatus
+puglSetVulkanSwapchain(PuglView* const                         view,
+                       PFN_vkGetInstanceProcAddr               getProcAddr,
+                       const VkInstance                        instance,
+                       const PuglVulkanSwapchainOptions* const options)
+{
+  PuglInternals* const              impl = view->impl;
+  const PuglX11VulkanSurface* const old =
+    (const PuglX11VulkanSurface*)impl->surface;
+
+  if (!impl->win) {
+    return PUGL_FAILURE;
+  }
+
+  if (old && old->drawing) {
+    return PUGL_BAD_CALL;
+  }
+
+  // Destroy any existing swapchain
+  puglX11VulkanFreeSurface(view);
+  if (!options) {
+    return PUGL_SUCCESS;
+  }
+
+  PuglX11VulkanSurface* const surface =
+    (PuglX11VulkanSurface*)calloc(1, sizeof(PuglX11VulkanSurface));
+  if (!surface) {
+    return PUGL_NO_MEMORY;
+  }
+
+  surface->options = *options;
+  surface->options.numFrames =
+    MAX(1U, MIN(options->numFrames, PUGL_VULKAN_MAX_FRAMES));
+
+  if (!puglX11VulkanLoadFuncs(
+        getProcAddr, instance, options->device, &surface->vk)) {
+    free(surface);
+    return PUGL_UNSUPPORTED;
+  }
+
+  // Choose how to report frames being shown, if at all
+  if ((options->flags & PUGL_VULKAN_PRESENT_WAIT) &&
+      surface->vk.waitForPresent) {
+    surface->timing = PUGL_VULKAN_PRESENT_WAIT;
+  } else if ((options->flags & PUGL_VULKAN_DISPLAY_TIMING) &&
+             surface->vk.getPastPresentationTiming) {
+    surface->timing = PUGL_VULKAN_DISPLAY_TIMING;
+  }
+
+  if (surface->timing) {
+    impl->pollPresents = puglX11VulkanPollPresents;
+  }
+
+  impl->surface = surface;
+
+  // Create the objects for each frame in flight, with fences already free
+  const PuglX11VulkanFuncs* const         vk   = &surface->vk;
+  const PuglVulkanSwapchainOptions* const opts = &surface->options;
+
+  const VkSemaphoreCreateInfo semaphoreInfo = {
+    VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, NULL, 0U};
+
+  const VkFenceCreateInfo fenceInfo = {
+    VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, NULL, VK_FENCE_CREATE_SIGNALED_BIT};
+
+  for (uint32_t i = 0U; i < opts->numFrames; ++i) {
+    if (vk->createSemaphore(opts->device,
+                            &semaphoreInfo,
+                            opts->allocator,
+                            &surface->acquired[i]) ||
+        vk->createFence(
+          opts->device, &fenceInfo, opts->allocator, &surface->fences[i])) {
+      puglX11VulkanFreeSurface(view);
+      return PUGL_CREATE_CONTEXT_FAILED;
+    }
+  }
+
+  if (puglX11VulkanCreateSwapchain(view, surface)) {
+    puglX11VulkanFreeSurface(view);
+    return PUGL_CREATE_CONTEXT_FAILED;
+  }
+
+  return PUGL_SUCCESS;
+}
+
 const PuglBackend*
 puglVulkanBackend(void)
 {
   static const PuglBackend backend = {puglX11Configure,
                                       puglStubCreate,
-                                      puglStubDestroy,
-                                      puglStubEnter,
-                                      puglStubLeave,
-                                      puglStubGetContext};
+                                      puglX11VulkanDestroy,
+                                      puglX11VulkanEnter,
+                                      puglX11VulkanLeave,
+                                      puglX11VulkanGetContext,
+                                      puglStubScroll};
 
   return &backend;
 }
@@ -122,3 +867,36 @@ puglCreateSurface(PFN_vkGetInstanceProcAddr          vkGetInstanceProcAddr,
 
   return vkCreateXlibSurfaceKHR(instance, &info, allocator, surface);
 }
+
+const char* const*
+puglGetHeadlessInstanceExtensions(uint32_t* const count)
+{
+  static const char* const extensions[] = {"VK_KHR_surface",
+                                           "VK_EXT_headless_surface"};
+
+  *count = 2;
+  return extensions;
+}
+
+VkResult
+puglCreateHeadlessSurface(PFN_vkGetInstanceProcAddr    vkGetInstanceProcAddr,
+                          VkInstance                   instance,
+                          const VkAllocationCallbacks* allocator,
+                          VkSurfaceKHR*                surface)
+{
+  PFN_vkCreateHeadlessSurfaceEXT vkCreateHeadlessSurfaceEXT =
+    (PFN_vkCreateHeadlessSurfaceEXT)vkGetInstanceProcAddr(
+      instance, "vkCreateHeadlessSurfaceEXT");
+
+  if (!vkCreateHeadlessSurfaceEXT) {
+    return VK_ERROR_EXTENSION_NOT_PRESENT;
+  }
+
+  const VkHeadlessSurfaceCreateInfoEXT info = {
+    VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT,
+    NULL,
+    0,
+  };
+
+  return vkCreateHeadlessSurfaceEXT(instance, &info, allocator, surface);
+}
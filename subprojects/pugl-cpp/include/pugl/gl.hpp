@@ -1,4 +1,4 @@
-// Copyright 2012-2025 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 #ifndef PUGL_GL_HPP
@@ -26,6 +26,27 @@ getProcAddress(const char* name) noexcept
   return puglGetProcAddress(name);
 }
 
+/// @copydoc puglSwapBuffers
+inline Status
+swapBuffers(View& view) noexcept
+{
+  return static_cast<Status>(puglSwapBuffers(view.cobj()));
+}
+
+/// @copydoc puglGetBufferAge
+inline unsigned
+getBufferAge(const View& view) noexcept
+{
+  return puglGetBufferAge(view.cobj());
+}
+
+/// @copydoc puglSetSharedContext
+inline Status
+setSharedContext(View& view, View& other) noexcept
+{
+  return static_cast<Status>(puglSetSharedContext(view.cobj(), other.cobj()));
+}
+
 /// @copydoc puglEnterContext
 inline Status
 enterContext(View& view) noexcept
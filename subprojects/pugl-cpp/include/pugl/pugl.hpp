@@ -78,6 +78,9 @@ using Point = PuglPoint;
 /// @copydoc PuglArea
 using Area = PuglArea;
 
+/// @copydoc PuglRect
+using Rect = PuglRect;
+
 /// @copydoc PuglStringHint
 enum class StringHint {
   applicationName, ///< @copydoc PUGL_APPLICATION_NAME
@@ -221,6 +224,9 @@ using DataOfferEvent = Event<PUGL_DATA_OFFER, PuglDataOfferEvent>;
 /// @copydoc PuglDataEvent
 using DataEvent = Event<PUGL_DATA, PuglDataEvent>;
 
+/// @copydoc PuglPresentEvent
+using PresentEvent = Event<PUGL_PRESENT, PuglPresentEvent>;
+
 /**
    @}
    @defgroup pugl_cpp_status Status
@@ -270,10 +276,13 @@ static_assert(static_cast<WorldType>(PUGL_MODULE) == WorldType::module);
 
 /// @copydoc PuglWorldFlag
 enum class WorldFlag {
-  threads = PUGL_WORLD_THREADS, ///< @copydoc PUGL_WORLD_THREADS
+  threads    = PUGL_WORLD_THREADS,     ///< @copydoc PUGL_WORLD_THREADS
+  groupSwaps = PUGL_WORLD_GROUP_SWAPS, ///< @copydoc PUGL_WORLD_GROUP_SWAPS
 };
 
 static_assert(static_cast<WorldFlag>(PUGL_WORLD_THREADS) == WorldFlag::threads);
+static_assert(static_cast<WorldFlag>(PUGL_WORLD_GROUP_SWAPS) ==
+              WorldFlag::groupSwaps);
 
 /// @copydoc PuglWorldFlags
 using WorldFlags = PuglWorldFlags;
@@ -380,6 +389,30 @@ public:
   {
     return static_cast<Status>(puglUpdate(cobj(), timeout));
   }
+
+  /// @copydoc puglGetWorldFd
+  int fd() const noexcept { return puglGetWorldFd(cobj()); }
+
+  /// @copydoc puglGetWakeFd
+  int wakeFd() const noexcept { return puglGetWakeFd(cobj()); }
+
+  /// @copydoc puglGetNextDeadline
+  double nextDeadline() const noexcept { return puglGetNextDeadline(cobj()); }
+
+  /// @copydoc puglPrepareUpdate
+  Status prepareUpdate(double& timeout) noexcept
+  {
+    return static_cast<Status>(puglPrepareUpdate(cobj(), &timeout));
+  }
+
+  /// @copydoc puglCheckUpdate
+  bool checkUpdate() noexcept { return puglCheckUpdate(cobj()); }
+
+  /// @copydoc puglDispatchUpdate
+  Status dispatchUpdate() noexcept
+  {
+    return static_cast<Status>(puglDispatchUpdate(cobj()));
+  }
 };
 
 /**
@@ -433,9 +466,16 @@ enum class ViewHint {
   refreshRate,         ///< @copydoc PUGL_REFRESH_RATE
   viewType,            ///< @copydoc PUGL_VIEW_TYPE
   darkFrame,           ///< @copydoc PUGL_DARK_FRAME
+  acceptDrop,          ///< @copydoc PUGL_ACCEPT_DROP
+  coalesceConfigure,   ///< @copydoc PUGL_COALESCE_CONFIGURE
+  coalescePointer,     ///< @copydoc PUGL_COALESCE_POINTER
+  preserveContents,    ///< @copydoc PUGL_PRESERVE_CONTENTS
+  surfaceType,         ///< @copydoc PUGL_SURFACE_TYPE
+  renderThread,        ///< @copydoc PUGL_RENDER_THREAD
 };
 
-static_assert(static_cast<ViewHint>(PUGL_DARK_FRAME) == ViewHint::darkFrame);
+static_assert(static_cast<ViewHint>(PUGL_RENDER_THREAD) ==
+              ViewHint::renderThread);
 
 /// @copydoc PuglViewHintValue
 using ViewHintValue = PuglViewHintValue;
@@ -678,6 +718,18 @@ public:
     return static_cast<Status>(puglObscureRegion(cobj(), x, y, width, height));
   }
 
+  /// @copydoc puglScrollRegion
+  Status scroll(const int      x,
+                const int      y,
+                const unsigned width,
+                const unsigned height,
+                const int      dx,
+                const int      dy)
+  {
+    return static_cast<Status>(
+      puglScrollRegion(cobj(), x, y, width, height, dx, dy));
+  }
+
   /**
      @}
      @name Interaction
@@ -870,6 +922,13 @@ public:
     return static_cast<Status>(puglSendEvent(cobj(), &cEvent));
   }
 
+  /// @copydoc puglPostClientEvent
+  Status postClientEvent(const std::uintptr_t data1,
+                         const std::uintptr_t data2) noexcept
+  {
+    return static_cast<Status>(puglPostClientEvent(cobj(), data1, data2));
+  }
+
   /**
      @}
   */
@@ -929,6 +988,8 @@ private:
       return target.onEvent(DataOfferEvent{event->offer});
     case PUGL_DATA:
       return target.onEvent(DataEvent{event->data});
+    case PUGL_PRESENT:
+      return target.onEvent(PresentEvent{event->present});
     }
 
     return Status::failure;
@@ -1,4 +1,4 @@
-// Copyright 2012-2025 David Robillard <d@drobilla.net>
+// Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
 /*
@@ -149,6 +149,43 @@ createSurface(PFN_vkGetInstanceProcAddr          vkGetInstanceProcAddr,
     vkGetInstanceProcAddr, view.cobj(), instance, allocator, surface);
 }
 
+/**
+   Get the instance extensions required for a headless surface.
+
+   @return An array of extension name strings.
+*/
+inline StaticStringArray
+getHeadlessInstanceExtensions() noexcept
+{
+  uint32_t                 count = 0;
+  const char* const* const extensions =
+    puglGetHeadlessInstanceExtensions(&count);
+
+  return StaticStringArray{extensions, count};
+}
+
+/// @copydoc puglCreateHeadlessSurface
+inline VkResult
+createHeadlessSurface(PFN_vkGetInstanceProcAddr          vkGetInstanceProcAddr,
+                      VkInstance                         instance,
+                      const VkAllocationCallbacks* const allocator,
+                      VkSurfaceKHR* const                surface) noexcept
+{
+  return puglCreateHeadlessSurface(
+    vkGetInstanceProcAddr, instance, allocator, surface);
+}
+
+/// @copydoc puglSetVulkanSwapchain
+inline Status
+setVulkanSwapchain(View&                             view,
+                   PFN_vkGetInstanceProcAddr         vkGetInstanceProcAddr,
+                   VkInstance                        instance,
+                   const PuglVulkanSwapchainOptions* options) noexcept
+{
+  return static_cast<Status>(puglSetVulkanSwapchain(
+    view.cobj(), vkGetInstanceProcAddr, instance, options));
+}
+
 /// @copydoc puglVulkanBackend
 inline const PuglBackend*
 vulkanBackend() noexcept
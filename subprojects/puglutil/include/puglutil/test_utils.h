@@ -76,6 +76,19 @@ crossingModeString(const PuglCrossingMode mode)
   return "unknown";
 }
 
+static inline const char*
+presentKindString(const PuglPresentKind kind)
+{
+  switch (kind) {
+  case PUGL_PRESENT_COMPLETE:
+    return "complete";
+  case PUGL_PRESENT_IDLE:
+    return "idle";
+  }
+
+  return "unknown";
+}
+
 static inline const char*
 scrollDirectionString(const PuglScrollDirection direction)
 {
@@ -369,6 +382,11 @@ printEvent(const PuglEvent* event, const char* prefix, const bool verbose)
       "%sData offer at   " PFFMT "\n", prefix, event->offer.x, event->offer.y);
   case PUGL_DATA:
     return PRINT("%sData\n", prefix);
+  case PUGL_PRESENT:
+    return PRINT("%sPresent %s %" PRIu32 "\n",
+                 prefix,
+                 presentKindString(event->present.kind),
+                 event->present.serial);
   default:
     break;
   }
@@ -467,6 +485,16 @@ puglViewHintString(const PuglViewHint hint)
     return "Dark frame";
   case PUGL_ACCEPT_DROP:
     return "Accept drop";
+  case PUGL_COALESCE_CONFIGURE:
+    return "Coalesce configure";
+  case PUGL_COALESCE_POINTER:
+    return "Coalesce pointer";
+  case PUGL_PRESERVE_CONTENTS:
+    return "Preserve contents";
+  case PUGL_SURFACE_TYPE:
+    return "Surface type";
+  case PUGL_RENDER_THREAD:
+    return "Render thread";
   }
 
   return "Unknown";
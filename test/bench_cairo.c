@@ -0,0 +1,161 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Benchmarks continuously redrawing a view with the Cairo backend.
+
+  This redraws a small "meter" region, then the whole view, every frame as
+  fast as possible, and reports the average time per frame for each.  The
+  drawing itself is trivial, so this mostly measures the overhead of setting
+  up and flushing the drawing surfaces.  This is repeated for each type of
+  surface, as reported by the view after it's realized.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/cairo.h>
+#include <pugl/pugl.h>
+
+#include <cairo.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define NUM_FRAMES 1000U // NOLINT(*-macro-to-enum)
+
+static const PuglSpan viewSize = 512U;
+static const PuglRect meter    = {16, 16, 16, 128};
+
+static const int surfaceTypes[] = {
+  PUGL_SERVER_SURFACE,
+  PUGL_IMAGE_SURFACE,
+  PUGL_SHARED_IMAGE_SURFACE,
+};
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  PuglRect        region;
+  size_t          numExposes;
+  bool            animating;
+} PuglBench;
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglBench* const bench = (PuglBench*)puglGetHandle(view);
+
+  if (event->type == PUGL_UPDATE && bench->animating) {
+    const PuglRect r = bench->region;
+    puglObscureRegion(view, r.x, r.y, r.width, r.height);
+  } else if (event->type == PUGL_EXPOSE) {
+    const PuglExposeEvent* const expose = &event->expose;
+    cairo_t* const               cr     = (cairo_t*)puglGetContext(view);
+
+    assert(cr);
+    cairo_rectangle(cr, expose->x, expose->y, expose->width, expose->height);
+    cairo_set_source_rgb(cr, 0.0, (double)(bench->numExposes % 2U), 0.0);
+    cairo_fill(cr);
+    ++bench->numExposes;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static double
+runFrames(PuglBench* const bench, const PuglRect region)
+{
+  bench->region     = region;
+  bench->numExposes = 0U;
+  bench->animating  = true;
+
+  const double startTime = puglGetTime(bench->world);
+  while (bench->numExposes < NUM_FRAMES) {
+    assert(!puglUpdate(bench->world, 0.0));
+  }
+  const double endTime = puglGetTime(bench->world);
+
+  bench->animating = false;
+  return (endTime - startTime) / (double)NUM_FRAMES;
+}
+
+static const char*
+surfaceTypeString(const int type)
+{
+  switch (type) {
+  case PUGL_SERVER_SURFACE:
+    return "server";
+  case PUGL_IMAGE_SURFACE:
+    return "image";
+  case PUGL_SHARED_IMAGE_SURFACE:
+    return "shared image";
+  default:
+    break;
+  }
+
+  return "unknown";
+}
+
+static void
+runBenchmark(PuglBench* const bench, const int surfaceType)
+{
+  // Set up and show view
+  bench->view = puglNewView(bench->world);
+  puglSetViewString(bench->view, PUGL_WINDOW_TITLE, "Pugl Cairo Benchmark");
+  puglSetHandle(bench->view, bench);
+  puglSetBackend(bench->view, puglCairoBackend());
+  puglSetEventFunc(bench->view, onEvent);
+  puglSetSizeHint(bench->view, PUGL_DEFAULT_SIZE, viewSize, viewSize);
+  puglSetPositionHint(bench->view, PUGL_DEFAULT_POSITION, 128, 128);
+  puglSetViewHint(bench->view, PUGL_SURFACE_TYPE, surfaceType);
+  assert(!puglRealize(bench->view));
+  assert(puglShow(bench->view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+
+  // Wait for the initial expose
+  bench->numExposes = 0U;
+  while (!bench->numExposes) {
+    assert(!puglUpdate(bench->world, 0.1));
+  }
+
+  // Redraw a small region, then the whole view, many times
+  const PuglRect whole     = {0, 0, viewSize, viewSize};
+  const double   meterTime = runFrames(bench, meter);
+  const double   wholeTime = runFrames(bench, whole);
+
+  // Print results (the surface type may have fallen back to a simpler one)
+  const int actualType = puglGetViewHint(bench->view, PUGL_SURFACE_TYPE);
+  printf("Surface:     %s\n", surfaceTypeString(actualType));
+  printf("Meter frame: %f ms\n", meterTime * 1e3);
+  printf("Whole frame: %f ms\n", wholeTime * 1e3);
+
+  puglFreeView(bench->view);
+  bench->view = NULL;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglBench bench = {puglNewWorld(PUGL_PROGRAM, 0),
+                     NULL,
+                     puglParseTestOptions(&argc, &argv),
+                     {0, 0, 0U, 0U},
+                     0U,
+                     false};
+
+  puglSetWorldString(bench.world, PUGL_CLASS_NAME, "PuglBench");
+  printf("Frames:      %u\n", NUM_FRAMES);
+
+  // Run the benchmark with every type of surface
+  const size_t numTypes = sizeof(surfaceTypes) / sizeof(surfaceTypes[0]);
+  for (size_t i = 0U; i < numTypes; ++i) {
+    runBenchmark(&bench, surfaceTypes[i]);
+  }
+
+  puglFreeWorld(bench.world);
+  return 0;
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Benchmarks realizing many OpenGL views in a single world.
+
+  This realizes many views with the same hints, like a host opening several
+  plugin GUIs at once, and measures how long it takes.  The first view
+  includes choosing a configuration and querying extensions, which later
+  views can reuse.
+*/
+
+#undef NDEBUG
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_VIEWS 50U // NOLINT(*-macro-to-enum)
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  (void)view;
+  (void)event;
+  return PUGL_SUCCESS;
+}
+
+int
+main(void)
+{
+  PuglWorld* const world = puglNewWorld(PUGL_PROGRAM, 0);
+  PuglView** const views = (PuglView**)calloc(NUM_VIEWS, sizeof(PuglView*));
+
+  puglSetWorldString(world, PUGL_CLASS_NAME, "PuglBench");
+
+  // Set up and realize many views, timing the first separately
+  double       firstTime = 0.0;
+  const double start     = puglGetTime(world);
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    PuglView* const view = puglNewView(world);
+
+    puglSetBackend(view, puglGlBackend());
+    puglSetEventFunc(view, onEvent);
+    puglSetViewHint(view, PUGL_DEPTH_BITS, 24);
+    puglSetViewHint(view, PUGL_STENCIL_BITS, 8);
+    puglSetSizeHint(view, PUGL_DEFAULT_SIZE, 64, 64);
+    puglSetPositionHint(view, PUGL_DEFAULT_POSITION, 0, 0);
+    assert(!puglRealize(view));
+
+    views[i] = view;
+    if (i == 0U) {
+      firstTime = puglGetTime(world) - start;
+    }
+  }
+  const double totalTime = puglGetTime(world) - start;
+
+  // Print results
+  const double restTime = totalTime - firstTime;
+  printf("Views:       %u\n", NUM_VIEWS);
+  printf("Realize:     %f s\n", totalTime);
+  printf("First view:  %f ms\n", firstTime * 1e3);
+  printf("Per view:    %f ms\n", restTime / (double)(NUM_VIEWS - 1U) * 1e3);
+
+  // Tear down
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    puglFreeView(views[i]);
+  }
+
+  free(views);
+  puglFreeWorld(world);
+
+  return 0;
+}
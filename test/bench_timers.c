@@ -0,0 +1,171 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Benchmarks many timers spread across several views.
+
+  This starts thousands of timers with slightly different periods in random
+  order, runs the event loop for a while, and reports how long starting and
+  stopping them takes, the total rate of timer events, and how much the time
+  between successive events of each timer deviates from its period (jitter).
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_VIEWS 10U         // NOLINT(*-macro-to-enum)
+#define TIMERS_PER_VIEW 1000U // NOLINT(*-macro-to-enum)
+#define NUM_TIMERS (NUM_VIEWS * TIMERS_PER_VIEW)
+
+static const double runDuration = 2.0;
+static const double minPeriod   = 1 / 60.0;
+static const double periodStep  = 0.00001;
+
+typedef struct {
+  double period;
+  double lastTime;
+  size_t numEvents;
+} TimerStats;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       views[NUM_VIEWS];
+  PuglTestOptions opts;
+  TimerStats*     stats;
+  size_t          numEvents;
+  size_t          numIntervals;
+  double          totalJitter;
+  double          maxJitter;
+} PuglBench;
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglBench* const bench = (PuglBench*)puglGetHandle(view);
+
+  if (event->type == PUGL_TIMER) {
+    assert(event->timer.id < NUM_TIMERS);
+
+    TimerStats* const stats = &bench->stats[event->timer.id];
+    const double      now   = puglGetTime(bench->world);
+
+    if (stats->numEvents++) {
+      const double jitter = fabs(now - stats->lastTime - stats->period);
+
+      bench->totalJitter += jitter;
+      bench->maxJitter = jitter > bench->maxJitter ? jitter : bench->maxJitter;
+      ++bench->numIntervals;
+    }
+
+    stats->lastTime = now;
+    ++bench->numEvents;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglBench bench = {puglNewWorld(PUGL_PROGRAM, 0),
+                     {NULL},
+                     puglParseTestOptions(&argc, &argv),
+                     (TimerStats*)calloc(NUM_TIMERS, sizeof(TimerStats)),
+                     0U,
+                     0U,
+                     0.0,
+                     0.0};
+
+  puglSetWorldString(bench.world, PUGL_CLASS_NAME, "PuglBench");
+
+  // Set up and realize views
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    PuglView* const view = puglNewView(bench.world);
+
+    puglSetBackend(view, puglStubBackend());
+    puglSetHandle(view, &bench);
+    puglSetEventFunc(view, onEvent);
+    puglSetSizeHint(view, PUGL_DEFAULT_SIZE, 64, 64);
+    puglSetPositionHint(view, PUGL_DEFAULT_POSITION, 0, 0);
+    assert(!puglRealize(view));
+
+    bench.views[i] = view;
+  }
+
+  // Shuffle the timer IDs, so timers aren't always added in order
+  uintptr_t* const ids = (uintptr_t*)calloc(NUM_TIMERS, sizeof(uintptr_t));
+  for (uintptr_t id = 0U; id < NUM_TIMERS; ++id) {
+    ids[id] = id;
+  }
+
+  srand(1U);
+  for (size_t i = NUM_TIMERS - 1U; i > 0U; --i) {
+    const size_t    j   = (size_t)rand() % (i + 1U);
+    const uintptr_t tmp = ids[i];
+    ids[i]              = ids[j];
+    ids[j]              = tmp;
+  }
+
+  // Start timers with slightly different periods
+  const double startStart = puglGetTime(bench.world);
+  for (size_t i = 0U; i < NUM_TIMERS; ++i) {
+    const uintptr_t id     = ids[i];
+    PuglView* const view   = bench.views[id / TIMERS_PER_VIEW];
+    const double    period = minPeriod + ((double)id * periodStep);
+
+    bench.stats[id].period = period;
+    assert(!puglStartTimer(view, id, period));
+  }
+  const double startEnd = puglGetTime(bench.world);
+
+  // Run the event loop
+  const double runStart = puglGetTime(bench.world);
+  double       t        = runStart;
+  while (t < runStart + runDuration) {
+    assert(!puglUpdate(bench.world, runStart + runDuration - t));
+    t = puglGetTime(bench.world);
+  }
+  const double runTime = t - runStart;
+
+  // Stop all timers
+  const double stopStart = puglGetTime(bench.world);
+  for (size_t i = 0U; i < NUM_TIMERS; ++i) {
+    const uintptr_t id = ids[NUM_TIMERS - 1U - i];
+    assert(!puglStopTimer(bench.views[id / TIMERS_PER_VIEW], id));
+  }
+  const double stopEnd = puglGetTime(bench.world);
+
+  // Print results
+  const double meanJitter =
+    bench.numIntervals ? bench.totalJitter / (double)bench.numIntervals : 0.0;
+
+  printf("Timers:      %u\n", NUM_TIMERS);
+  printf("Start:       %f ms\n", (startEnd - startStart) * 1e3);
+  printf("Stop:        %f ms\n", (stopEnd - stopStart) * 1e3);
+  printf("Events:      %zu\n", bench.numEvents);
+  printf("Event rate:  %.0f Hz\n", (double)bench.numEvents / runTime);
+  printf("Mean jitter: %f ms\n", meanJitter * 1e3);
+  printf("Max jitter:  %f ms\n", bench.maxJitter * 1e3);
+
+  // Tear down
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    puglFreeView(bench.views[i]);
+  }
+
+  free(ids);
+  free(bench.stats);
+  puglFreeWorld(bench.world);
+
+  return 0;
+}
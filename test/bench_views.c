@@ -0,0 +1,116 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Benchmarks dispatching events to many views in a single world.
+
+  This sends a client event to every view several times, and measures how
+  long it takes to dispatch them all, which is dominated by looking up the
+  view for each event when there are many views.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_VIEWS 1000U // NOLINT(*-macro-to-enum)
+#define NUM_ROUNDS 10U  // NOLINT(*-macro-to-enum)
+#define BATCH_SIZE 100U // NOLINT(*-macro-to-enum)
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView**      views;
+  PuglTestOptions opts;
+  size_t          numReceived;
+} PuglBench;
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglBench* bench = (PuglBench*)puglGetHandle(view);
+
+  if (event->type == PUGL_CLIENT) {
+    assert(event->client.data1 == (uintptr_t)view);
+    ++bench->numReceived;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglBench bench = {puglNewWorld(PUGL_PROGRAM, 0),
+                     (PuglView**)calloc(NUM_VIEWS, sizeof(PuglView*)),
+                     puglParseTestOptions(&argc, &argv),
+                     0U};
+
+  puglSetWorldString(bench.world, PUGL_CLASS_NAME, "PuglBench");
+
+  // Set up and realize many views
+  const double realizeStart = puglGetTime(bench.world);
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    PuglView* const view = puglNewView(bench.world);
+
+    puglSetBackend(view, puglStubBackend());
+    puglSetHandle(view, &bench);
+    puglSetEventFunc(view, onEvent);
+    puglSetSizeHint(view, PUGL_DEFAULT_SIZE, 64, 64);
+    puglSetPositionHint(view, PUGL_DEFAULT_POSITION, 0, 0);
+    assert(!puglRealize(view));
+
+    bench.views[i] = view;
+  }
+  const double realizeEnd = puglGetTime(bench.world);
+
+  // Send events to every view in batches, updating after every batch
+  const size_t numEvents     = (size_t)NUM_VIEWS * NUM_ROUNDS;
+  const double dispatchStart = puglGetTime(bench.world);
+  for (size_t r = 0U; r < NUM_ROUNDS; ++r) {
+    for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+      PuglView* const view  = bench.views[i];
+      PuglEvent       event = {{PUGL_CLIENT, 0U}};
+
+      event.client.data1 = (uintptr_t)view;
+      assert(!puglSendEvent(view, &event));
+
+      if ((i + 1U) % BATCH_SIZE == 0U) {
+        assert(!puglUpdate(bench.world, 0.0));
+      }
+    }
+  }
+
+  while (bench.numReceived < numEvents) {
+    assert(!puglUpdate(bench.world, 0.1));
+  }
+  const double dispatchEnd = puglGetTime(bench.world);
+
+  // Print results
+  const double dispatchTime = dispatchEnd - dispatchStart;
+  printf("Views:       %u\n", NUM_VIEWS);
+  printf("Realize:     %f s\n", realizeEnd - realizeStart);
+  printf("Events:      %zu\n", numEvents);
+  printf("Dispatch:    %f s\n", dispatchTime);
+  printf("Per event:   %f us\n", dispatchTime / (double)numEvents * 1e6);
+  printf("Event rate:  %.0f Hz\n", (double)numEvents / dispatchTime);
+
+  // Tear down
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    puglFreeView(bench.views[i]);
+  }
+
+  free(bench.views);
+  puglFreeWorld(bench.world);
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Benchmarks creating and destroying worlds.
+
+  This measures the latency of setting up a world, which is dominated by
+  round trips to the window system server (for example, to intern atoms on
+  X11), and so is much higher with a remote or heavily loaded server.
+*/
+
+#undef NDEBUG
+
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define NUM_WORLDS 100U // NOLINT(*-macro-to-enum)
+
+int
+main(void)
+{
+  // Use a separate long-lived world as a clock
+  PuglWorld* const clock = puglNewWorld(PUGL_PROGRAM, 0);
+  assert(clock);
+
+  double minTime = 1.0e9;
+  double maxTime = 0.0;
+  double total   = 0.0;
+  for (size_t i = 0U; i < NUM_WORLDS; ++i) {
+    const double     start = puglGetTime(clock);
+    PuglWorld* const world = puglNewWorld(PUGL_MODULE, 0);
+    const double     end   = puglGetTime(clock);
+
+    assert(world);
+    puglFreeWorld(world);
+
+    const double elapsed = end - start;
+    minTime = elapsed < minTime ? elapsed : minTime;
+    maxTime = elapsed > maxTime ? elapsed : maxTime;
+    total += elapsed;
+  }
+
+  // Print results
+  printf("Worlds:      %u\n", NUM_WORLDS);
+  printf("Min create:  %f ms\n", minTime * 1e3);
+  printf("Mean create: %f ms\n", total / (double)NUM_WORLDS * 1e3);
+  printf("Max create:  %f ms\n", maxTime * 1e3);
+
+  puglFreeWorld(clock);
+  return 0;
+}
@@ -5,6 +5,7 @@
 #include <pugl/cairo.h>      // IWYU pragma: keep
 #include <pugl/gl.h>         // IWYU pragma: keep
 #include <pugl/glu.h>        // IWYU pragma: keep
+#include <pugl/pixels.h>     // IWYU pragma: keep
 #include <pugl/pugl.h>       // IWYU pragma: keep
 #include <pugl/stub.h>       // IWYU pragma: keep
 
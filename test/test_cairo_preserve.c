@@ -0,0 +1,145 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that a Cairo view preserves its contents between exposes.
+
+  For each surface type, this fills the view on the first expose, then
+  resizes it and obscures a small region, and checks that the pixels drawn
+  by the first expose are still there at the start of the later ones.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/cairo.h>
+#include <pugl/pugl.h>
+
+#include <cairo.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+static const uint32_t fillColor = 0x0000FF00U;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  unsigned        numExposes;
+} PuglTest;
+
+/// Return the RGB value of a pixel of the surface being drawn to
+static uint32_t
+getPixel(cairo_t* const cr, const int x, const int y)
+{
+  cairo_surface_t* const      target  = cairo_get_target(cr);
+  const cairo_rectangle_int_t extents = {x, y, 1, 1};
+
+  cairo_surface_flush(target);
+
+  cairo_surface_t* const image = cairo_surface_map_to_image(target, &extents);
+  assert(!cairo_surface_status(image));
+
+  const uint32_t pixel =
+    *(const uint32_t*)(const void*)cairo_image_surface_get_data(image);
+
+  cairo_surface_unmap_image(target, image);
+  return pixel & 0x00FFFFFFU;
+}
+
+static void
+onExpose(PuglTest* const test, const PuglExposeEvent* const event)
+{
+  cairo_t* const cr = (cairo_t*)puglGetContext(test->view);
+  assert(cr);
+
+  if (!test->numExposes) {
+    // Fill the exposed region on the first expose
+    cairo_rectangle(cr, event->x, event->y, event->width, event->height);
+    cairo_set_source_rgb(cr, 0.0, 1.0, 0.0);
+    cairo_fill(cr);
+  } else {
+    // Check that the first frame is still there without drawing anything
+    assert(getPixel(cr, 8, 8) == fillColor);
+  }
+
+  ++test->numExposes;
+}
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_EXPOSE) {
+    onExpose(test, &event->expose);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void
+runTest(PuglTest* const test, const int surfaceType)
+{
+  // Set up view
+  test->view       = puglNewView(test->world);
+  test->numExposes = 0U;
+  puglSetViewString(test->view, PUGL_WINDOW_TITLE, "Pugl Cairo Preserve Test");
+  puglSetHandle(test->view, test);
+  puglSetBackend(test->view, puglCairoBackend());
+  puglSetEventFunc(test->view, onEvent);
+  puglSetSizeHint(test->view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test->view, PUGL_DEFAULT_POSITION, 384, 896);
+  puglSetViewHint(test->view, PUGL_SURFACE_TYPE, surfaceType);
+  puglSetViewHint(test->view, PUGL_PRESERVE_CONTENTS, PUGL_TRUE);
+
+  // Check that the hint reads back, since Cairo always supports it
+  assert(!puglRealize(test->view));
+  assert(puglGetViewHint(test->view, PUGL_PRESERVE_CONTENTS) == PUGL_TRUE);
+
+  // Drive event loop until the view gets exposed
+  assert(puglShow(test->view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (!test->numExposes) {
+    assert(!puglUpdate(test->world, -1.0));
+  }
+
+  // Resize the view and drive event loop until it's exposed again
+  assert(!puglSetSizeHint(test->view, PUGL_CURRENT_SIZE, 320, 320));
+  assert(!puglObscureView(test->view));
+  while (test->numExposes < 2U) {
+    assert(!puglUpdate(test->world, 0.1));
+  }
+
+  // Obscure a small region and drive event loop until it's exposed
+  assert(!puglObscureRegion(test->view, 128, 128, 32, 32));
+  while (test->numExposes < 3U) {
+    assert(!puglUpdate(test->world, 0.1));
+  }
+
+  puglFreeView(test->view);
+  test->view = NULL;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   0U};
+
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+
+  runTest(&test, PUGL_SERVER_SURFACE);
+  runTest(&test, PUGL_IMAGE_SURFACE);
+  runTest(&test, PUGL_SHARED_IMAGE_SURFACE);
+
+  puglFreeWorld(test.world);
+  return 0;
+}
@@ -0,0 +1,162 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that configure events are coalesced with PUGL_COALESCE_CONFIGURE.
+
+  This uses a child view, since its size isn't managed by a window manager,
+  resizes it several times without updating, then checks that at most one
+  configure event is received per update, before any expose.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NUM_RESIZES 8U // NOLINT(*-macro-to-enum)
+
+typedef enum {
+  START,
+  REALIZED,
+  CONFIGURED,
+  EXPOSED,
+} State;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       parent;
+  PuglView*       child;
+  PuglTestOptions opts;
+  State           state;
+  PuglArea        configuredSize;
+  size_t          numConfigures;
+  bool            exposedAfterConfigure;
+} PuglTest;
+
+static PuglStatus
+onParentEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Parent: ", true);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+onChildEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Child:  ", true);
+  }
+
+  switch (event->type) {
+  case PUGL_REALIZE:
+    assert(test->state == START);
+    test->state = REALIZED;
+    break;
+  case PUGL_CONFIGURE:
+    assert(!test->exposedAfterConfigure);
+    if (test->state == REALIZED) {
+      test->state = CONFIGURED;
+    }
+    test->configuredSize.width  = event->configure.width;
+    test->configuredSize.height = event->configure.height;
+    ++test->numConfigures;
+    break;
+  case PUGL_EXPOSE:
+    if (test->state == CONFIGURED) {
+      test->state = EXPOSED;
+    }
+    test->exposedAfterConfigure = test->numConfigures > 0U;
+    break;
+  default:
+    break;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void
+update(PuglTest* const test, const double timeout)
+{
+  test->numConfigures         = 0U;
+  test->exposedAfterConfigure = false;
+  assert(!puglUpdate(test->world, timeout));
+  assert(test->numConfigures <= 1U);
+}
+
+int
+main(int argc, char** argv)
+{
+  static const PuglSpan initialSize = 64U;
+
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START,
+                   {0U, 0U},
+                   0U,
+                   false};
+
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+
+  // Set up parent view
+  test.parent = puglNewView(test.world);
+  puglSetViewString(test.parent, PUGL_WINDOW_TITLE, "Pugl Coalesce Test");
+  puglSetBackend(test.parent, puglStubBackend());
+  puglSetHandle(test.parent, &test);
+  puglSetEventFunc(test.parent, onParentEvent);
+  puglSetSizeHint(test.parent, PUGL_DEFAULT_SIZE, 512, 512);
+  puglSetPositionHint(test.parent, PUGL_DEFAULT_POSITION, 384, 384);
+  assert(!puglRealize(test.parent));
+  assert(puglShow(test.parent, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+
+  // Set up child view with coalesced configuration
+  test.child = puglNewView(test.world);
+  puglSetParent(test.child, puglGetNativeView(test.parent));
+  puglSetBackend(test.child, puglStubBackend());
+  puglSetHandle(test.child, &test);
+  puglSetEventFunc(test.child, onChildEvent);
+  puglSetViewHint(test.child, PUGL_COALESCE_CONFIGURE, PUGL_TRUE);
+  puglSetSizeHint(test.child, PUGL_DEFAULT_SIZE, initialSize, initialSize);
+  puglSetPositionHint(test.child, PUGL_DEFAULT_POSITION, 16, 16);
+  assert(puglGetViewHint(test.child, PUGL_COALESCE_CONFIGURE) == PUGL_TRUE);
+  assert(!puglRealize(test.child));
+  assert(puglShow(test.child, PUGL_SHOW_PASSIVE) <= PUGL_FAILURE);
+  while (test.state < EXPOSED) {
+    update(&test, 0.1);
+  }
+
+  // Resize the child several times without dispatching events
+  PuglSpan size = initialSize;
+  for (unsigned i = 0U; i < NUM_RESIZES; ++i) {
+    size = (PuglSpan)(size + 8U);
+    assert(!puglSetSizeHint(test.child, PUGL_CURRENT_SIZE, size, size));
+  }
+
+  // Update until the final size is configured (once per update at most)
+  while (test.configuredSize.width != size ||
+         test.configuredSize.height != size) {
+    update(&test, 0.1);
+  }
+
+  // Tear down
+  puglFreeView(test.child);
+  puglFreeView(test.parent);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
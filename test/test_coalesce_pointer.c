@@ -0,0 +1,169 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that motion events are coalesced with PUGL_COALESCE_POINTER.
+
+  This sends several motion events to the view at once, then checks that a
+  single motion event is received in the next update, with every sent event
+  in the motion history.  Then it sends a single motion event, and checks
+  that its history contains only that event.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NUM_MOTIONS 8U // NOLINT(*-macro-to-enum)
+
+typedef enum {
+  START,
+  EXPOSED,
+  MOVED,
+} State;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  State           state;
+  size_t          numSent;
+  size_t          numMotionEvents;
+} PuglTest;
+
+static void
+onMotion(PuglTest* const test, const PuglMotionEvent* const event)
+{
+  size_t numMotions = 0U;
+
+  const PuglMotionEvent* const motions =
+    puglGetMotionHistory(test->view, &numMotions);
+
+  // Check that every sent event is in the history, oldest first
+  assert(numMotions == test->numSent);
+  for (size_t i = 0U; i < numMotions; ++i) {
+    assert(motions[i].x == (double)(i + 1U));
+    assert(motions[i].y == (double)(i + 1U));
+  }
+
+  // Check that the merged event has the latest position
+  assert(event->x == (double)test->numSent);
+  assert(event->y == (double)test->numSent);
+
+  ++test->numMotionEvents;
+  test->state = MOVED;
+}
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  switch (event->type) {
+  case PUGL_EXPOSE:
+    if (test->state == START) {
+      test->state = EXPOSED;
+    }
+    break;
+
+  case PUGL_MOTION:
+    onMotion(test, &event->motion);
+    break;
+
+  default:
+    break;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void
+sendMotions(PuglTest* const test, const unsigned numMotions)
+{
+  Display* const display = (Display*)puglGetNativeWorld(test->world);
+  const Window   window  = (Window)puglGetNativeView(test->view);
+
+  test->numSent = numMotions;
+  for (unsigned i = 1U; i <= numMotions; ++i) {
+    XEvent xevent = {MotionNotify};
+
+    xevent.xmotion.display     = display;
+    xevent.xmotion.window      = window;
+    xevent.xmotion.root        = DefaultRootWindow(display);
+    xevent.xmotion.time        = i;
+    xevent.xmotion.x           = (int)i;
+    xevent.xmotion.y           = (int)i;
+    xevent.xmotion.same_screen = True;
+
+    assert(XSendEvent(display, window, False, 0L, &xevent));
+  }
+
+  // Wait until the server has sent every event back to be read at once
+  XSync(display, False);
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START,
+                   0U,
+                   0U};
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(
+    test.view, PUGL_WINDOW_TITLE, "Pugl Coalesce Pointer Test");
+  puglSetBackend(test.view, puglStubBackend());
+  puglSetHandle(test.view, &test);
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 640, 128);
+  puglSetViewHint(test.view, PUGL_COALESCE_POINTER, PUGL_TRUE);
+
+  // Create and show window
+  assert(!puglRealize(test.view));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.state < EXPOSED) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Send several motion events and check that they arrive as one
+  sendMotions(&test, NUM_MOTIONS);
+  assert(!puglUpdate(test.world, 0.0));
+  assert(test.state == MOVED);
+  assert(test.numMotionEvents == 1U);
+
+  // Check that there is no motion history after the motion event
+  size_t numMotions = 1U;
+  assert(!puglGetMotionHistory(test.view, &numMotions));
+  assert(!numMotions);
+
+  // Send a single motion event and check that it's its own history
+  sendMotions(&test, 1U);
+  assert(!puglUpdate(test.world, 0.0));
+  assert(test.numMotionEvents == 2U);
+
+  // Tear down
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
@@ -0,0 +1,199 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that the configuration of a view is tracked from X11 events.
+
+  This sends a synthetic configure event to a top-level view, like a window
+  manager does when a window is moved, and checks that its position and size
+  are taken from the event.  Then it moves and resizes a child view, and
+  checks that the configuration reported for it matches the server.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+
+#include <assert.h>
+#include <stdbool.h>
+
+typedef enum {
+  START,
+  EXPOSED,
+} State;
+
+typedef struct {
+  PuglWorld*         world;
+  PuglView*          parent;
+  PuglView*          child;
+  PuglTestOptions    opts;
+  State              state;
+  PuglConfigureEvent configure;
+} PuglTest;
+
+static PuglStatus
+onParentEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Parent: ", true);
+  }
+
+  if (event->type == PUGL_CONFIGURE) {
+    test->configure = event->configure;
+  } else if (event->type == PUGL_EXPOSE && test->state == START) {
+    test->state = EXPOSED;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+onChildEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Child:  ", true);
+  }
+
+  if (event->type == PUGL_CONFIGURE) {
+    test->configure = event->configure;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static bool
+isConfigured(const PuglConfigureEvent* const configure,
+             const PuglCoord                 x,
+             const PuglCoord                 y,
+             const PuglSpan                  width,
+             const PuglSpan                  height)
+{
+  return configure->type == PUGL_CONFIGURE && configure->x == x &&
+         configure->y == y && configure->width == width &&
+         configure->height == height;
+}
+
+static void
+checkCurrentHints(PuglView* const view, const PuglConfigureEvent* configure)
+{
+  const PuglPoint pos  = puglGetPositionHint(view, PUGL_CURRENT_POSITION);
+  const PuglArea  size = puglGetSizeHint(view, PUGL_CURRENT_SIZE);
+
+  assert(pos.x == configure->x);
+  assert(pos.y == configure->y);
+  assert(size.width == configure->width);
+  assert(size.height == configure->height);
+}
+
+static void
+sendConfigure(PuglTest* const test)
+{
+  Display* const display = (Display*)puglGetNativeWorld(test->world);
+  const Window   window  = (Window)puglGetNativeView(test->parent);
+  XEvent         xevent  = {ConfigureNotify};
+
+  xevent.xconfigure.display = display;
+  xevent.xconfigure.event   = window;
+  xevent.xconfigure.window  = window;
+  xevent.xconfigure.x       = 100;
+  xevent.xconfigure.y       = 200;
+  xevent.xconfigure.width   = 300;
+  xevent.xconfigure.height  = 150;
+
+  assert(XSendEvent(display, window, False, StructureNotifyMask, &xevent));
+  XSync(display, False);
+}
+
+static void
+checkChildGeometry(PuglTest* const test)
+{
+  Display* const display = (Display*)puglGetNativeWorld(test->world);
+  const Window   window  = (Window)puglGetNativeView(test->child);
+  Window         root    = 0;
+  int            x       = 0;
+  int            y       = 0;
+  unsigned       width   = 0U;
+  unsigned       height  = 0U;
+  unsigned       border  = 0U;
+  unsigned       depth   = 0U;
+
+  assert(XGetGeometry(
+    display, window, &root, &x, &y, &width, &height, &border, &depth));
+
+  assert(test->configure.x == x);
+  assert(test->configure.y == y);
+  assert(test->configure.width == width);
+  assert(test->configure.height == height);
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START,
+                   {PUGL_NOTHING, 0U, 0, 0, 0U, 0U, 0U}};
+
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+
+  // Set up parent view
+  test.parent = puglNewView(test.world);
+  puglSetViewString(test.parent, PUGL_WINDOW_TITLE, "Pugl Configure Test");
+  puglSetBackend(test.parent, puglStubBackend());
+  puglSetHandle(test.parent, &test);
+  puglSetEventFunc(test.parent, onParentEvent);
+  puglSetSizeHint(test.parent, PUGL_DEFAULT_SIZE, 512, 512);
+  puglSetPositionHint(test.parent, PUGL_DEFAULT_POSITION, 384, 384);
+  assert(!puglRealize(test.parent));
+  assert(puglShow(test.parent, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.state < EXPOSED) {
+    assert(!puglUpdate(test.world, 0.1));
+  }
+
+  // Send a synthetic configure event and check that it's used as is
+  sendConfigure(&test);
+  assert(!puglUpdate(test.world, 0.0));
+  assert(isConfigured(&test.configure, 100, 200, 300U, 150U));
+  checkCurrentHints(test.parent, &test.configure);
+
+  // Set up child view
+  test.configure.type = PUGL_NOTHING;
+  test.child          = puglNewView(test.world);
+  puglSetParent(test.child, puglGetNativeView(test.parent));
+  puglSetBackend(test.child, puglStubBackend());
+  puglSetHandle(test.child, &test);
+  puglSetEventFunc(test.child, onChildEvent);
+  puglSetSizeHint(test.child, PUGL_DEFAULT_SIZE, 64, 64);
+  puglSetPositionHint(test.child, PUGL_DEFAULT_POSITION, 16, 16);
+  assert(!puglRealize(test.child));
+  assert(puglShow(test.child, PUGL_SHOW_PASSIVE) <= PUGL_FAILURE);
+
+  // Move and resize the child and check that the configuration matches
+  assert(!puglSetPositionHint(test.child, PUGL_CURRENT_POSITION, 24, 32));
+  assert(!puglSetSizeHint(test.child, PUGL_CURRENT_SIZE, 96, 48));
+  while (!isConfigured(&test.configure, 24, 32, 96U, 48U)) {
+    assert(!puglUpdate(test.world, 0.1));
+  }
+
+  checkCurrentHints(test.child, &test.configure);
+  checkChildGeometry(&test);
+
+  // Tear down
+  puglFreeView(test.child);
+  puglFreeView(test.parent);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that separate obscured regions are exposed as separate rectangles.
+
+  This obscures two small regions in opposite corners of the view while
+  handling an update event, then checks that the following expose has a
+  bounding box that covers both, but rectangles that don't cover the middle of
+  the view.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum {
+  START,
+  EXPOSED,
+  OBSCURED,
+  DAMAGED,
+} State;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  State           state;
+} PuglTest;
+
+static const double   timeout   = 1 / 60.0;
+static const PuglSpan viewSize  = 256U;
+static const PuglRect corners[] = {{2, 4, 8, 16}, {240, 232, 8, 16}};
+
+static bool
+rectContains(const PuglRect outer, const PuglRect inner)
+{
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.width <= outer.x + outer.width &&
+         inner.y + inner.height <= outer.y + outer.height;
+}
+
+static bool
+regionContains(const PuglRect* const rects,
+               const size_t          numRects,
+               const PuglRect        rect)
+{
+  for (size_t i = 0U; i < numRects; ++i) {
+    if (rectContains(rects[i], rect)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void
+checkExpose(PuglTest* const test, const PuglExposeEvent* const expose)
+{
+  const PuglRect bounds = {expose->x, expose->y, expose->width, expose->height};
+
+  size_t          numRects = 0U;
+  const PuglRect* rects    = puglGetExposeRects(test->view, &numRects);
+
+  assert(!numRects == !rects);
+  for (size_t i = 0U; i < numRects; ++i) {
+    assert(rectContains(bounds, rects[i]));
+  }
+
+  assert(rectContains(bounds, corners[0]));
+  assert(rectContains(bounds, corners[1]));
+
+  /* Check that the region covers both corners, but not the middle, unless
+     this isn't supported (and the whole bounding box must be drawn).  If the
+     window system exposed more at the same time, try again. */
+  const PuglRect middle = {64, 64, 128, 128};
+  if (!numRects || (regionContains(rects, numRects, corners[0]) &&
+                    regionContains(rects, numRects, corners[1]) &&
+                    !regionContains(rects, numRects, middle))) {
+    test->state = DAMAGED;
+  } else {
+    test->state = EXPOSED;
+  }
+}
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  switch (event->type) {
+  case PUGL_UPDATE:
+    if (test->state == EXPOSED) {
+      for (size_t i = 0U; i < 2U; ++i) {
+        const PuglRect r = corners[i];
+        assert(!puglObscureRegion(view, r.x, r.y, r.width, r.height));
+      }
+      test->state = OBSCURED;
+    }
+    break;
+
+  case PUGL_EXPOSE:
+    if (test->state == START) {
+      test->state = EXPOSED;
+    } else if (test->state == OBSCURED) {
+      checkExpose(test, &event->expose);
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START};
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Damage Test");
+  puglSetBackend(test.view, puglStubBackend());
+  puglSetHandle(test.view, &test);
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, viewSize, viewSize);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 640, 640);
+
+  // Check that there are no expose rectangles outside an expose
+  size_t numRects = 1U;
+  assert(!puglGetExposeRects(test.view, &numRects));
+  assert(!numRects);
+
+  // Create and show window, then update until the regions are exposed
+  assert(!puglRealize(test.view));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.state != DAMAGED) {
+    assert(!puglUpdate(test.world, timeout));
+  }
+
+  // Tear down
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that a world can be driven by a foreign event loop.
+
+  This runs a simple poll() loop using the world's file descriptors and the
+  prepare/check/dispatch functions instead of puglUpdate(), and checks that
+  the view is exposed, that a timer fires, and that posting an event wakes up
+  the loop.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <math.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static const uintptr_t timerId     = 1U;
+static const double    timerPeriod = 1 / 60.0;
+static const uintptr_t postedData  = 42U;
+
+typedef enum {
+  START,
+  EXPOSED,
+  TIMED,
+  POSTED,
+} State;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  State           state;
+} PuglTest;
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_EXPOSE && test->state == START) {
+    test->state = EXPOSED;
+  } else if (event->type == PUGL_TIMER && test->state == EXPOSED) {
+    assert(event->timer.id == timerId);
+    test->state = TIMED;
+  } else if (event->type == PUGL_CLIENT && test->state == TIMED) {
+    assert(event->client.data1 == postedData);
+    test->state = POSTED;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void
+iterate(PuglTest* const test)
+{
+  // Prepare and determine how long to wait
+  double timeout = 0.0;
+  assert(!puglPrepareUpdate(test->world, &timeout));
+  assert(timeout < 0.0 || timeout <= timerPeriod);
+
+  // Wait for the world's file descriptors (at most a second, to be safe)
+  struct pollfd pfds[] = {{puglGetWorldFd(test->world), POLLIN, 0},
+                          {puglGetWakeFd(test->world), POLLIN, 0}};
+  const int     ms     = timeout < 0.0 ? 1000 : (int)ceil(timeout * 1000.0);
+  assert(poll(pfds, 2, ms) >= 0);
+
+  // Dispatch if there's anything to do
+  if (puglCheckUpdate(test->world)) {
+    assert(puglDispatchUpdate(test->world) <= PUGL_FAILURE);
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START};
+
+  assert(puglGetWorldFd(test.world) >= 0);
+  assert(puglGetWakeFd(test.world) >= 0);
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Foreign Loop Test");
+  puglSetBackend(test.view, puglStubBackend());
+  puglSetHandle(test.view, &test);
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 384, 384);
+
+  // Create and show window
+  assert(!puglRealize(test.view));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+
+  // Iterate until an expose happens
+  while (test.state < EXPOSED) {
+    iterate(&test);
+  }
+
+  // Start a timer and check that the deadline reflects it
+  const double startTime = puglGetTime(test.world);
+  assert(!puglStartTimer(test.view, timerId, timerPeriod));
+
+  const double deadline = puglGetNextDeadline(test.world);
+  assert(deadline >= 0.0);
+  assert(deadline <= startTime + timerPeriod + 0.1);
+
+  // Iterate until the timer fires
+  while (test.state < TIMED) {
+    iterate(&test);
+  }
+
+  assert(!puglStopTimer(test.view, timerId));
+
+  // Post an event and check that it makes the wake file descriptor readable
+  assert(!puglPostClientEvent(test.view, postedData, 0U));
+  struct pollfd wake = {puglGetWakeFd(test.world), POLLIN, 0};
+  assert(poll(&wake, 1, 0) == 1);
+
+  // Iterate until the posted event is dispatched
+  while (test.state < POSTED) {
+    iterate(&test);
+  }
+
+  // Check that dispatching reset the wake file descriptor
+  assert(!poll(&wake, 1, 0));
+
+  // Tear down
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
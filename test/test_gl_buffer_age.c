@@ -0,0 +1,99 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that the age of the OpenGL back buffer is reported while drawing.
+
+  This requests preserved contents, draws a full frame and then a small
+  region, and checks that the buffer age is consistent with the actual value
+  of the #PUGL_PRESERVE_CONTENTS hint.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stdbool.h>
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  unsigned        numExposes;
+} PuglTest;
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_EXPOSE) {
+    const unsigned age      = puglGetBufferAge(view);
+    const bool     preserve = puglGetViewHint(view, PUGL_PRESERVE_CONTENTS);
+
+    // The second frame only needs to redraw the exposed region if preserved
+    if (test->numExposes > 0U && preserve) {
+      assert(age == 1U);
+    }
+
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ++test->numExposes;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   0U};
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Buffer Age Test");
+  puglSetHandle(test.view, &test);
+  puglSetBackend(test.view, puglGlBackend());
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 384, 896);
+  puglSetViewHint(test.view, PUGL_DOUBLE_BUFFER, 1);
+  puglSetViewHint(test.view, PUGL_PRESERVE_CONTENTS, PUGL_TRUE);
+
+  // Check that the hint is set to whether contents are actually preserved
+  assert(!puglRealize(test.view));
+  const int preserve = puglGetViewHint(test.view, PUGL_PRESERVE_CONTENTS);
+  assert(preserve == PUGL_FALSE || preserve == PUGL_TRUE);
+  assert(!puglGetBufferAge(test.view));
+
+  // Drive event loop until the view gets exposed
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (!test.numExposes) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Obscure a small region and drive event loop until it's exposed
+  assert(!puglObscureRegion(test.view, 16, 16, 32, 32));
+  while (test.numExposes < 2U) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Check that the age is only available while drawing
+  assert(!puglGetBufferAge(test.view));
+
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+  return 0;
+}
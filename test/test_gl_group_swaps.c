@@ -0,0 +1,172 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that several OpenGL views can be drawn with grouped swaps.
+
+  This shows two vsynced views in a world with swaps grouped, and redraws
+  both several times.  If the swap interval of a window can be queried, this
+  checks that whenever every view is drawn in an update, all but the last are
+  swapped without waiting for the refresh.  The time taken is only reported,
+  since it depends on the display and the load on the machine.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <GL/glx.h>
+#include <X11/Xlib.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_VIEWS 2U   // NOLINT(*-macro-to-enum)
+#define NUM_FRAMES 32U // NOLINT(*-macro-to-enum)
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       views[NUM_VIEWS];
+  PuglTestOptions opts;
+  unsigned        numExposes[NUM_VIEWS];
+  unsigned        numFrames;
+} PuglTest;
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test  = (PuglTest*)puglGetWorldHandle(puglGetWorld(view));
+  const size_t    index = (size_t)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_UPDATE) {
+    if (test->numExposes[index] < test->numFrames) {
+      assert(!puglObscureView(view));
+    }
+  } else if (event->type == PUGL_EXPOSE) {
+    glClearColor(0.0f, 0.0f, index ? 1.0f : 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ++test->numExposes[index];
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static bool
+isDone(const PuglTest* const test)
+{
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    if (test->numExposes[i] < test->numFrames) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Return true if the swap interval of a view's window can be queried
+static bool
+canQuerySwapInterval(const PuglTest* const test)
+{
+  Display* const    display = (Display*)puglGetNativeWorld(test->world);
+  const char* const extensions =
+    glXQueryExtensionsString(display, DefaultScreen(display));
+
+  return extensions && strstr(extensions, "GLX_EXT_swap_control");
+}
+
+/// Return the swap interval that a view's window was last swapped with
+static unsigned
+getSwapInterval(const PuglTest* const test, const size_t index)
+{
+  Display* const display  = (Display*)puglGetNativeWorld(test->world);
+  const Window   window   = (Window)puglGetNativeView(test->views[index]);
+  unsigned       interval = 0U;
+
+  glXQueryDrawable(display, window, GLX_SWAP_INTERVAL_EXT, &interval);
+  return interval;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, PUGL_WORLD_GROUP_SWAPS),
+                   {NULL, NULL},
+                   puglParseTestOptions(&argc, &argv),
+                   {0U, 0U},
+                   1U};
+
+  puglSetWorldHandle(test.world, &test);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+
+  // Set up and show views
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    PuglView* const view = puglNewView(test.world);
+
+    puglSetViewString(view, PUGL_WINDOW_TITLE, "Pugl Group Swaps Test");
+    puglSetHandle(view, (void*)i);
+    puglSetBackend(view, puglGlBackend());
+    puglSetEventFunc(view, onEvent);
+    puglSetSizeHint(view, PUGL_DEFAULT_SIZE, 256, 256);
+    puglSetPositionHint(
+      view, PUGL_DEFAULT_POSITION, 384 + (288 * (int)i), 896);
+    puglSetViewHint(view, PUGL_DOUBLE_BUFFER, 1);
+    puglSetViewHint(view, PUGL_SWAP_INTERVAL, 1);
+    assert(puglShow(view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+    test.views[i] = view;
+  }
+
+  // Drive event loop until every view has drawn a first frame
+  while (!isDone(&test)) {
+    assert(!puglUpdate(test.world, 0.1));
+  }
+
+  // Draw several more frames as fast as possible
+  const bool   canQuery  = canQuerySwapInterval(&test);
+  const double startTime = puglGetTime(test.world);
+  test.numFrames += NUM_FRAMES;
+  while (!isDone(&test)) {
+    unsigned lastExposes[NUM_VIEWS] = {0U, 0U};
+    bool     drewAll                = true;
+    for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+      lastExposes[i] = test.numExposes[i];
+    }
+
+    assert(!puglUpdate(test.world, 0.0));
+
+    for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+      drewAll = drewAll && test.numExposes[i] > lastExposes[i];
+    }
+
+    // Check that only the last view waited for the refresh if all were drawn
+    if (canQuery && drewAll) {
+      for (size_t i = 0U; i < NUM_VIEWS - 1U; ++i) {
+        assert(getSwapInterval(&test, i) == 0U);
+      }
+
+      assert(getSwapInterval(&test, NUM_VIEWS - 1U) == 1U);
+    }
+  }
+
+  const double elapsed = puglGetTime(test.world) - startTime;
+  if (test.opts.verbose) {
+    fprintf(stderr, "%u frames took %f seconds\n", NUM_FRAMES, elapsed);
+  }
+
+  // Tear down
+  for (size_t i = 0U; i < NUM_VIEWS; ++i) {
+    puglFreeView(test.views[i]);
+  }
+
+  puglFreeWorld(test.world);
+  return 0;
+}
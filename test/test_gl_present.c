@@ -0,0 +1,102 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that swapped OpenGL frames are reported when they're shown.
+
+  This draws a few frames synchronized to the refresh, then drives the event
+  loop until the world has no deadline left.  If frame timing is supported,
+  this checks that every frame was reported in order, otherwise no present
+  events should have been sent at all.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+#define NUM_FRAMES 3U // NOLINT(*-macro-to-enum)
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  unsigned        numExposes;
+  uint32_t        lastShown;
+  double          lastTime;
+} PuglTest;
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_UPDATE && test->numExposes < NUM_FRAMES) {
+    puglObscureView(view);
+  } else if (event->type == PUGL_EXPOSE) {
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ++test->numExposes;
+  } else if (event->type == PUGL_PRESENT) {
+    // Check that frames are reported once each, in order
+    assert(event->present.kind == PUGL_PRESENT_COMPLETE);
+    assert(event->present.serial > test->lastShown);
+    assert(event->present.serial <= test->numExposes);
+    assert(event->present.time >= test->lastTime);
+    test->lastShown = event->present.serial;
+    test->lastTime  = event->present.time;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   0U,
+                   0U,
+                   0.0};
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl GL Present Test");
+  puglSetHandle(test.view, &test);
+  puglSetBackend(test.view, puglGlBackend());
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 384, 896);
+  puglSetViewHint(test.view, PUGL_DOUBLE_BUFFER, 1);
+  puglSetViewHint(test.view, PUGL_SWAP_INTERVAL, 1);
+  assert(!puglRealize(test.view));
+
+  // Drive event loop until a few frames have been drawn
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.numExposes < NUM_FRAMES) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Drive event loop until there's nothing left to wait for
+  while (puglGetNextDeadline(test.world) >= 0.0) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Check that either every frame or none of them were reported
+  assert(!test.lastShown || test.lastShown == test.numExposes);
+
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+  return 0;
+}
@@ -0,0 +1,147 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests drawing an OpenGL view on a separate render thread.
+
+  The event handler forwards exposures to a render thread, which enters the
+  context, draws, and swaps buffers, while the main thread keeps dispatching
+  events until several frames have been drawn.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NUM_FRAMES 4U // NOLINT(*-macro-to-enum)
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  pthread_t       thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t  cond;
+  unsigned        numExposes;
+  unsigned        numFrames;
+  bool            quit;
+} PuglTest;
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_UPDATE) {
+    pthread_mutex_lock(&test->mutex);
+    if (test->numFrames == test->numExposes && test->numFrames < NUM_FRAMES) {
+      assert(!puglObscureView(view));
+    }
+    pthread_mutex_unlock(&test->mutex);
+  } else if (event->type == PUGL_EXPOSE) {
+    // Hand the expose off to the render thread
+    pthread_mutex_lock(&test->mutex);
+    ++test->numExposes;
+    pthread_cond_signal(&test->cond);
+    pthread_mutex_unlock(&test->mutex);
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void*
+render(void* const arg)
+{
+  PuglTest* const test = (PuglTest*)arg;
+
+  pthread_mutex_lock(&test->mutex);
+  while (!test->quit) {
+    if (test->numFrames == test->numExposes) {
+      pthread_cond_wait(&test->cond, &test->mutex);
+      continue;
+    }
+
+    // Draw a frame without holding the lock
+    pthread_mutex_unlock(&test->mutex);
+    assert(!puglEnterContext(test->view));
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    assert(!puglSwapBuffers(test->view));
+    assert(!puglLeaveContext(test->view));
+    pthread_mutex_lock(&test->mutex);
+
+    ++test->numFrames;
+  }
+  pthread_mutex_unlock(&test->mutex);
+
+  return NULL;
+}
+
+static unsigned
+getNumFrames(PuglTest* const test)
+{
+  pthread_mutex_lock(&test->mutex);
+  const unsigned numFrames = test->numFrames;
+  pthread_mutex_unlock(&test->mutex);
+  return numFrames;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {0};
+
+  test.world = puglNewWorld(PUGL_PROGRAM, PUGL_WORLD_THREADS);
+  test.opts  = puglParseTestOptions(&argc, &argv);
+  pthread_mutex_init(&test.mutex, NULL);
+  pthread_cond_init(&test.cond, NULL);
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Render Thread Test");
+  puglSetHandle(test.view, &test);
+  puglSetBackend(test.view, puglGlBackend());
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 384, 896);
+  puglSetViewHint(test.view, PUGL_SWAP_INTERVAL, 1);
+  puglSetViewHint(test.view, PUGL_RENDER_THREAD, PUGL_TRUE);
+
+  // Check that rendering on another thread is supported
+  assert(!puglRealize(test.view));
+  assert(puglGetViewHint(test.view, PUGL_RENDER_THREAD) == PUGL_TRUE);
+
+  // Start render thread and drive event loop until enough frames are drawn
+  assert(!pthread_create(&test.thread, NULL, render, &test));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (getNumFrames(&test) < NUM_FRAMES) {
+    assert(!puglUpdate(test.world, 0.01));
+  }
+
+  // Stop render thread
+  pthread_mutex_lock(&test.mutex);
+  test.quit = true;
+  pthread_cond_signal(&test.cond);
+  pthread_mutex_unlock(&test.mutex);
+  assert(!pthread_join(test.thread, NULL));
+
+  // Tear down
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+  pthread_cond_destroy(&test.cond);
+  pthread_mutex_destroy(&test.mutex);
+  return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that views can share OpenGL resources.
+
+  This creates a texture in the context of one view, and checks that it's
+  available in the context of another view that shares with it.
+*/
+
+#undef NDEBUG
+
+#include <pugl/gl.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stddef.h>
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  (void)view;
+  (void)event;
+  return PUGL_SUCCESS;
+}
+
+static PuglView*
+newView(PuglWorld* const world)
+{
+  PuglView* const view = puglNewView(world);
+
+  puglSetViewString(view, PUGL_WINDOW_TITLE, "Pugl OpenGL Share Test");
+  puglSetBackend(view, puglGlBackend());
+  puglSetEventFunc(view, onEvent);
+  puglSetSizeHint(view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(view, PUGL_DEFAULT_POSITION, 384, 896);
+  return view;
+}
+
+int
+main(void)
+{
+  PuglWorld* const world = puglNewWorld(PUGL_PROGRAM, 0);
+  PuglView* const  first = newView(world);
+  PuglView* const  other = newView(world);
+
+  puglSetWorldString(world, PUGL_CLASS_NAME, "PuglTest");
+
+  // Check that a view can't share with itself or before the other is realized
+  assert(puglSetSharedContext(first, first) == PUGL_BAD_PARAMETER);
+  assert(!puglSetSharedContext(other, first));
+  assert(puglRealize(other) == PUGL_BAD_CONFIGURATION);
+
+  // Realize the first view and create a texture in its context
+  GLuint texture = 0U;
+  assert(!puglRealize(first));
+  assert(puglSetSharedContext(first, other) == PUGL_FAILURE);
+  assert(!puglEnterContext(first));
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  assert(glIsTexture(texture));
+  assert(!puglLeaveContext(first));
+
+  // Realize the other view and check that the texture is available there
+  assert(!puglRealize(other));
+  assert(!puglEnterContext(other));
+  assert(glIsTexture(texture));
+  assert(!puglLeaveContext(other));
+
+  // Check that the texture outlives the view it was created in
+  puglFreeView(first);
+  assert(!puglEnterContext(other));
+  assert(glIsTexture(texture));
+  glDeleteTextures(1, &texture);
+  assert(!puglLeaveContext(other));
+
+  // Check that freeing a view forgets it as the shared view of others
+  PuglView* const last = newView(world);
+  assert(!puglSetSharedContext(last, other));
+  puglFreeView(other);
+  assert(!puglRealize(last));
+
+  puglFreeView(last);
+  puglFreeWorld(world);
+  return 0;
+}
@@ -0,0 +1,139 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that drawing to a view with the pixels backend works.
+
+  This draws to the pixel buffer with both shared and plain images, and
+  checks that the buffer is only available during an expose, and is large
+  enough to cover the exposed region.  If presenting at the display refresh
+  is supported, it also checks that a frame is presented after the expose.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pixels.h>
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  bool            exposed;
+  bool            presented;
+} PuglTest;
+
+static void
+onExpose(PuglView* const view, const PuglExposeEvent* const event)
+{
+  const PuglPixels* const pixels = (const PuglPixels*)puglGetContext(view);
+
+  assert(pixels);
+  assert(pixels->data);
+  assert(pixels->format == PUGL_PIXEL_FORMAT_XRGB32);
+  assert(pixels->stride >= (size_t)pixels->width * 4U);
+  assert(event->x + event->width <= (int)pixels->width);
+  assert(event->y + event->height <= (int)pixels->height);
+
+  // Fill the exposed region with green
+  for (int y = event->y; y < event->y + event->height; ++y) {
+    uint32_t* const row =
+      (uint32_t*)((uint8_t*)pixels->data + ((size_t)y * pixels->stride));
+
+    for (int x = event->x; x < event->x + event->width; ++x) {
+      row[x] = 0x0000FF00U;
+    }
+  }
+}
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_EXPOSE) {
+    onExpose(view, &event->expose);
+    test->exposed = true;
+  } else if (event->type == PUGL_PRESENT &&
+             event->present.kind == PUGL_PRESENT_COMPLETE) {
+    assert(test->exposed);
+    assert(event->present.serial >= 1U);
+    test->presented = true;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void
+runTest(PuglTest* const test, const int surfaceType, const int swapInterval)
+{
+  // Set up view
+  test->view      = puglNewView(test->world);
+  test->exposed   = false;
+  test->presented = false;
+  puglSetViewString(test->view, PUGL_WINDOW_TITLE, "Pugl Pixels Test");
+  puglSetHandle(test->view, test);
+  puglSetBackend(test->view, puglPixelsBackend());
+  puglSetEventFunc(test->view, onEvent);
+  puglSetSizeHint(test->view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test->view, PUGL_DEFAULT_POSITION, 384, 896);
+  puglSetViewHint(test->view, PUGL_SURFACE_TYPE, surfaceType);
+  puglSetViewHint(test->view, PUGL_SWAP_INTERVAL, swapInterval);
+
+  // Check that the surface type is set to an image type when realized
+  assert(!puglRealize(test->view));
+  const int actualType = puglGetViewHint(test->view, PUGL_SURFACE_TYPE);
+  assert(actualType == PUGL_IMAGE_SURFACE ||
+         actualType == PUGL_SHARED_IMAGE_SURFACE);
+  if (surfaceType == PUGL_IMAGE_SURFACE) {
+    assert(actualType == PUGL_IMAGE_SURFACE);
+  }
+
+  // Check that the swap interval is set to whether frames are presented
+  const int actualInterval = puglGetViewHint(test->view, PUGL_SWAP_INTERVAL);
+  assert(actualInterval == 0 || actualInterval == 1);
+  assert(actualInterval <= swapInterval);
+
+  // Drive event loop until the view gets exposed (and presented)
+  assert(!puglGetContext(test->view));
+  assert(puglShow(test->view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (!test->exposed || (actualInterval && !test->presented)) {
+    assert(!puglUpdate(test->world, -1.0));
+  }
+
+  // Check that the buffer is only available during an expose
+  assert(!puglGetContext(test->view));
+
+  puglFreeView(test->view);
+  test->view = NULL;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   false,
+                   false};
+
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+
+  runTest(&test, PUGL_SHARED_IMAGE_SURFACE, 0);
+  runTest(&test, PUGL_IMAGE_SURFACE, 0);
+  runTest(&test, PUGL_SHARED_IMAGE_SURFACE, 1);
+
+  puglFreeWorld(test.world);
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests posting client events to a view from several threads at once.
+
+  Each thread posts many events tagged with its index and a sequence number,
+  and the view checks that every event arrives, in order per thread, while
+  the event loop blocks until it's woken up by a post.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NUM_THREADS 4U           // NOLINT(*-macro-to-enum)
+#define EVENTS_PER_THREAD 10000U // NOLINT(*-macro-to-enum)
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  pthread_t       threads[NUM_THREADS];
+  uintptr_t       numReceived[NUM_THREADS];
+  size_t          numEvents;
+} PuglTest;
+
+typedef struct {
+  PuglTest* test;
+  uintptr_t index;
+} PostThread;
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (event->type == PUGL_CLIENT) {
+    const uintptr_t thread = event->client.data1;
+    assert(thread < NUM_THREADS);
+    assert(event->client.data2 == test->numReceived[thread]);
+    ++test->numReceived[thread];
+    ++test->numEvents;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+static void*
+postEvents(void* const arg)
+{
+  const PostThread* const thread = (const PostThread*)arg;
+
+  for (uintptr_t i = 0U; i < EVENTS_PER_THREAD; ++i) {
+    PuglStatus st = PUGL_SUCCESS;
+    while ((st = puglPostClientEvent(thread->test->view, thread->index, i))) {
+      // Queue is full, let the event loop catch up
+      assert(st == PUGL_FAILURE);
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   {0},
+                   {0U},
+                   0U};
+
+  PostThread threads[NUM_THREADS];
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetBackend(test.view, puglStubBackend());
+  puglSetHandle(test.view, &test);
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 384, 384);
+  assert(!puglRealize(test.view));
+
+  // Start threads that post events concurrently
+  for (uintptr_t i = 0U; i < NUM_THREADS; ++i) {
+    threads[i].test  = &test;
+    threads[i].index = i;
+    assert(!pthread_create(&test.threads[i], NULL, postEvents, &threads[i]));
+  }
+
+  // Block until all events have been received (posting wakes the loop)
+  const size_t numEvents = (size_t)NUM_THREADS * EVENTS_PER_THREAD;
+  while (test.numEvents < numEvents) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  for (unsigned i = 0U; i < NUM_THREADS; ++i) {
+    assert(!pthread_join(test.threads[i], NULL));
+    assert(test.numReceived[i] == EVENTS_PER_THREAD);
+  }
+
+  // Check that nothing more is received
+  assert(!puglUpdate(test.world, 0.0));
+  assert(test.numEvents == numEvents);
+
+  // Check that undispatched events are discarded when the view is freed
+  assert(!puglPostClientEvent(test.view, 0U, 0U));
+  puglFreeView(test.view);
+  assert(!puglUpdate(test.world, 0.0));
+  assert(test.numEvents == numEvents);
+
+  // Tear down
+  puglFreeWorld(test.world);
+
+  return 0;
+}
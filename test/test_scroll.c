@@ -0,0 +1,144 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that scrolling a region only exposes the revealed strip.
+
+  This scrolls the contents of the whole view up and to the left while
+  handling an update event, then checks that the following expose only covers
+  the strips along the bottom and right edges that were revealed.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/stub.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum {
+  START,
+  EXPOSED,
+  SCROLLED,
+  REVEALED,
+} State;
+
+typedef struct {
+  PuglWorld*      world;
+  PuglView*       view;
+  PuglTestOptions opts;
+  State           state;
+} PuglTest;
+
+static const double   timeout  = 1 / 60.0;
+static const PuglSpan viewSize = 256U;
+static const int      scrollDx = -8;
+static const int      scrollDy = -16;
+
+static bool
+rectContains(const PuglRect outer, const PuglRect inner)
+{
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         inner.x + inner.width <= outer.x + outer.width &&
+         inner.y + inner.height <= outer.y + outer.height;
+}
+
+static bool
+isRevealed(const PuglRect rect)
+{
+  const PuglRect bottom = {0, 240, 256, 16};
+  const PuglRect right  = {248, 0, 8, 240};
+
+  return rectContains(bottom, rect) || rectContains(right, rect);
+}
+
+static void
+checkExpose(PuglTest* const test, const PuglExposeEvent* const expose)
+{
+  const PuglRect bounds = {expose->x, expose->y, expose->width, expose->height};
+
+  size_t          numRects = 0U;
+  const PuglRect* rects    = puglGetExposeRects(test->view, &numRects);
+
+  /* Check that only the revealed strips are exposed.  If the window system
+     exposed more at the same time, try again. */
+  bool revealed = numRects ? true : isRevealed(bounds);
+  for (size_t i = 0U; i < numRects; ++i) {
+    revealed = revealed && isRevealed(rects[i]);
+  }
+
+  test->state = revealed ? REVEALED : EXPOSED;
+}
+
+static PuglStatus
+onEvent(PuglView* view, const PuglEvent* event)
+{
+  PuglTest* test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  switch (event->type) {
+  case PUGL_UPDATE:
+    if (test->state == EXPOSED) {
+      assert(!puglScrollRegion(
+        view, 0, 0, viewSize, viewSize, scrollDx, scrollDy));
+      test->state = SCROLLED;
+    }
+    break;
+
+  case PUGL_EXPOSE:
+    if (test->state == START) {
+      test->state = EXPOSED;
+    } else if (test->state == SCROLLED) {
+      checkExpose(test, &event->expose);
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   NULL,
+                   puglParseTestOptions(&argc, &argv),
+                   START};
+
+  // Set up view
+  test.view = puglNewView(test.world);
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Scroll Test");
+  puglSetBackend(test.view, puglStubBackend());
+  puglSetHandle(test.view, &test);
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, viewSize, viewSize);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 640, 128);
+
+  // Check that invalid offsets are rejected
+  assert(puglScrollRegion(test.view, 0, 0, 1U, 1U, 0, 0x10000) ==
+         PUGL_BAD_PARAMETER);
+
+  // Create and show window, then update until only the strips are exposed
+  assert(!puglRealize(test.view));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.state != REVEALED) {
+    assert(!puglUpdate(test.world, timeout));
+  }
+
+  // Tear down
+  puglFreeView(test.view);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
@@ -12,6 +12,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 typedef enum {
@@ -90,6 +91,11 @@ main(int argc, char** argv)
   // Check that puglGetNativeView() returns something
   assert(puglGetNativeView(test.view));
 
+  // Check that there is no motion history outside of a motion event
+  size_t numMotions = 1U;
+  assert(!puglGetMotionHistory(test.view, &numMotions));
+  assert(!numMotions);
+
   // Tear down
   puglFreeView(test.view);
   puglFreeWorld(test.world);
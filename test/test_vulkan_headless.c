@@ -0,0 +1,112 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests that a headless Vulkan surface can be used without a display.
+
+  This doesn't create a world or view at all, so it works without any window
+  system, and checks that the created surface is supported by a device.
+*/
+
+#undef NDEBUG
+
+#include <pugl/vulkan.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static VkInstance
+createInstance(void)
+{
+  uint32_t           nExtensions = 0U;
+  const char* const* extensions =
+    puglGetHeadlessInstanceExtensions(&nExtensions);
+
+  assert(nExtensions == 2U);
+
+  const VkApplicationInfo appInfo = {
+    VK_STRUCTURE_TYPE_APPLICATION_INFO,
+    NULL,
+    "Pugl Vulkan Headless Test",
+    VK_MAKE_VERSION(0, 1, 0),
+    "Pugl Vulkan Test Engine",
+    VK_MAKE_VERSION(0, 1, 0),
+    VK_MAKE_VERSION(1, 0, 0),
+  };
+
+  const VkInstanceCreateInfo createInfo = {
+    VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+    NULL,
+    0U,
+    &appInfo,
+    0U,
+    NULL,
+    nExtensions,
+    extensions,
+  };
+
+  VkInstance instance = VK_NULL_HANDLE;
+  assert(!vkCreateInstance(&createInfo, NULL, &instance));
+  return instance;
+}
+
+static bool
+isSupported(const VkInstance instance, const VkSurfaceKHR surface)
+{
+  uint32_t nDevices = 0U;
+  assert(!vkEnumeratePhysicalDevices(instance, &nDevices, NULL));
+
+  VkPhysicalDevice* const devices =
+    (VkPhysicalDevice*)calloc(nDevices, sizeof(VkPhysicalDevice));
+  assert(!vkEnumeratePhysicalDevices(instance, &nDevices, devices));
+
+  // Check that at least one device can present to the surface
+  bool supported = false;
+  for (uint32_t i = 0U; i < nDevices && !supported; ++i) {
+    const VkPhysicalDevice   device = devices[i];
+    VkSurfaceCapabilitiesKHR caps;
+    VkBool32                 queueSupported = VK_FALSE;
+
+    if (!vkGetPhysicalDeviceSurfaceSupportKHR(
+          device, 0U, surface, &queueSupported) &&
+        queueSupported &&
+        !vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &caps)) {
+      supported = caps.minImageCount >= 1U;
+    }
+  }
+
+  free(devices);
+  return supported;
+}
+
+int
+main(void)
+{
+  // Load Vulkan without a world
+  PuglVulkanLoader* const loader = puglNewVulkanLoader(NULL, NULL);
+  assert(loader);
+
+  const PFN_vkGetInstanceProcAddr getInstanceProcAddr =
+    puglGetInstanceProcAddrFunc(loader);
+  assert(getInstanceProcAddr);
+
+  // Create a headless surface and check that it's usable
+  const VkInstance instance = createInstance();
+  VkSurfaceKHR     surface  = VK_NULL_HANDLE;
+  assert(!puglCreateHeadlessSurface(
+    getInstanceProcAddr, instance, NULL, &surface));
+  assert(surface);
+  assert(isSupported(instance, surface));
+
+  // Tear down
+  vkDestroySurfaceKHR(instance, surface, NULL);
+  vkDestroyInstance(instance, NULL);
+  puglFreeVulkanLoader(loader);
+
+  return 0;
+}
@@ -0,0 +1,449 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+/*
+  Tests drawing to a view with a swapchain managed by Pugl.
+
+  This clears the image of each frame with a transfer, and checks that a
+  frame is only available during an expose, that the first frame has a newly
+  created swapchain, and that frames in flight are used in turn.  If the
+  device supports presentation timing, it also checks that frames are
+  reported as shown in order.
+*/
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+#include <pugl/vulkan.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N_FRAMES 2U    // NOLINT(*-macro-to-enum)
+#define N_EXPOSES 8U   // NOLINT(*-macro-to-enum)
+#define NO_FAMILY 255U // NOLINT(*-macro-to-enum)
+
+// Helper macro for allocating arrays by type, with C++ compatible cast
+#define AALLOC(size, Type) ((Type*)calloc(size, sizeof(Type)))
+
+typedef struct {
+  PuglWorld*       world;
+  PuglView*        view;
+  PuglTestOptions  opts;
+  VkInstance       instance;
+  VkSurfaceKHR     surface;
+  VkPhysicalDevice physicalDevice;
+  uint32_t         queueFamily;
+  VkDevice         device;
+  VkQueue          queue;
+  VkCommandPool    commandPool;
+  VkCommandBuffer  commandBuffers[N_FRAMES];
+  unsigned         numExposes;
+  uint32_t         timing;
+  uint32_t         lastShown;
+} PuglTest;
+
+static VkResult
+createInstance(PuglTest* const test)
+{
+  uint32_t           nExtensions = 0U;
+  const char* const* extensions  = puglGetInstanceExtensions(&nExtensions);
+
+  const VkApplicationInfo appInfo = {
+    VK_STRUCTURE_TYPE_APPLICATION_INFO,
+    NULL,
+    "Pugl Vulkan Swapchain Test",
+    VK_MAKE_VERSION(0, 1, 0),
+    "Pugl Vulkan Test Engine",
+    VK_MAKE_VERSION(0, 1, 0),
+    VK_MAKE_VERSION(1, 1, 0),
+  };
+
+  const VkInstanceCreateInfo createInfo = {
+    VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+    NULL,
+    0U,
+    &appInfo,
+    0U,
+    NULL,
+    nExtensions,
+    extensions,
+  };
+
+  return vkCreateInstance(&createInfo, NULL, &test->instance);
+}
+
+static uint32_t
+findQueueFamily(const PuglTest* const  test,
+                const VkPhysicalDevice physicalDevice)
+{
+  uint32_t nFamilies = 0U;
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &nFamilies, NULL);
+
+  VkQueueFamilyProperties* const families =
+    AALLOC(nFamilies, VkQueueFamilyProperties);
+
+  vkGetPhysicalDeviceQueueFamilyProperties(
+    physicalDevice, &nFamilies, families);
+
+  uint32_t result = NO_FAMILY;
+  for (uint32_t i = 0U; i < nFamilies && result == NO_FAMILY; ++i) {
+    VkBool32 supported = VK_FALSE;
+    if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+        !vkGetPhysicalDeviceSurfaceSupportKHR(
+          physicalDevice, i, test->surface, &supported) &&
+        supported) {
+      result = i;
+    }
+  }
+
+  free(families);
+  return result;
+}
+
+static bool
+hasDeviceExtension(const VkPhysicalDevice physicalDevice,
+                   const char* const      name)
+{
+  uint32_t nProps = 0U;
+  vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &nProps, NULL);
+
+  VkExtensionProperties* const props = AALLOC(nProps, VkExtensionProperties);
+  vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &nProps, props);
+
+  bool found = false;
+  for (uint32_t i = 0U; i < nProps && !found; ++i) {
+    found = !strcmp(props[i].extensionName, name);
+  }
+
+  free(props);
+  return found;
+}
+
+static bool
+hasPresentWait(const VkPhysicalDevice physicalDevice)
+{
+  if (!hasDeviceExtension(physicalDevice, VK_KHR_PRESENT_ID_EXTENSION_NAME) ||
+      !hasDeviceExtension(physicalDevice, VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+    return false;
+  }
+
+  VkPhysicalDevicePresentWaitFeaturesKHR waitFeatures = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+    NULL,
+    VK_FALSE};
+
+  VkPhysicalDevicePresentIdFeaturesKHR idFeatures = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+    &waitFeatures,
+    VK_FALSE};
+
+  VkPhysicalDeviceFeatures2 features = {0};
+  features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  features.pNext = &idFeatures;
+
+  vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+  return idFeatures.presentId && waitFeatures.presentWait;
+}
+
+static VkResult
+createDevice(PuglTest* const test)
+{
+  VkResult vr       = VK_SUCCESS;
+  uint32_t nDevices = 0U;
+  if ((vr = vkEnumeratePhysicalDevices(test->instance, &nDevices, NULL)) ||
+      !nDevices) {
+    return vr ? vr : VK_ERROR_INITIALIZATION_FAILED;
+  }
+
+  VkPhysicalDevice* const devices = AALLOC(nDevices, VkPhysicalDevice);
+  vkEnumeratePhysicalDevices(test->instance, &nDevices, devices);
+
+  // Use the first device that can draw to the surface
+  test->queueFamily = NO_FAMILY;
+  for (uint32_t i = 0U; i < nDevices && test->queueFamily == NO_FAMILY; ++i) {
+    test->physicalDevice = devices[i];
+    test->queueFamily    = findQueueFamily(test, devices[i]);
+  }
+
+  free(devices);
+  if (test->queueFamily == NO_FAMILY) {
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+  }
+
+  const float priority      = 1.0f;
+  const char* extensions[3] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME, NULL, NULL};
+  uint32_t    nExtensions   = 1U;
+
+  // Enable presentation timing if possible
+  VkPhysicalDevicePresentWaitFeaturesKHR waitFeatures = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR, NULL, VK_TRUE};
+
+  VkPhysicalDevicePresentIdFeaturesKHR idFeatures = {
+    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+    &waitFeatures,
+    VK_TRUE};
+
+  const void* features = NULL;
+  if (hasPresentWait(test->physicalDevice)) {
+    features                  = &idFeatures;
+    extensions[nExtensions++] = VK_KHR_PRESENT_ID_EXTENSION_NAME;
+    extensions[nExtensions++] = VK_KHR_PRESENT_WAIT_EXTENSION_NAME;
+    test->timing              = PUGL_VULKAN_PRESENT_WAIT;
+  } else if (hasDeviceExtension(test->physicalDevice,
+                                VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME)) {
+    extensions[nExtensions++] = VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME;
+    test->timing              = PUGL_VULKAN_DISPLAY_TIMING;
+  }
+
+  const VkDeviceQueueCreateInfo queueInfo = {
+    VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+    NULL,
+    0U,
+    test->queueFamily,
+    1U,
+    &priority,
+  };
+
+  const VkDeviceCreateInfo deviceInfo = {
+    VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+    features,
+    0U,
+    1U,
+    &queueInfo,
+    0U,
+    NULL,
+    nExtensions,
+    extensions,
+    NULL,
+  };
+
+  if ((vr = vkCreateDevice(
+         test->physicalDevice, &deviceInfo, NULL, &test->device))) {
+    return vr;
+  }
+
+  vkGetDeviceQueue(test->device, test->queueFamily, 0U, &test->queue);
+
+  const VkCommandPoolCreateInfo poolInfo = {
+    VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+    NULL,
+    VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+    test->queueFamily,
+  };
+
+  const VkCommandBufferAllocateInfo allocInfo = {
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+    NULL,
+    VK_NULL_HANDLE,
+    VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+    N_FRAMES,
+  };
+
+  if ((vr = vkCreateCommandPool(
+         test->device, &poolInfo, NULL, &test->commandPool))) {
+    return vr;
+  }
+
+  VkCommandBufferAllocateInfo info = allocInfo;
+  info.commandPool                 = test->commandPool;
+  return vkAllocateCommandBuffers(test->device, &info, test->commandBuffers);
+}
+
+static void
+recordBarrier(const VkCommandBuffer      commandBuffer,
+              const VkImage              image,
+              const VkImageLayout        oldLayout,
+              const VkImageLayout        newLayout,
+              const VkAccessFlags        srcAccess,
+              const VkAccessFlags        dstAccess,
+              const VkPipelineStageFlags srcStage,
+              const VkPipelineStageFlags dstStage)
+{
+  const VkImageMemoryBarrier barrier = {
+    VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+    NULL,
+    srcAccess,
+    dstAccess,
+    oldLayout,
+    newLayout,
+    VK_QUEUE_FAMILY_IGNORED,
+    VK_QUEUE_FAMILY_IGNORED,
+    image,
+    {VK_IMAGE_ASPECT_COLOR_BIT, 0U, 1U, 0U, 1U},
+  };
+
+  vkCmdPipelineBarrier(
+    commandBuffer, srcStage, dstStage, 0U, 0U, NULL, 0U, NULL, 1U, &barrier);
+}
+
+static void
+onExpose(PuglTest* const test)
+{
+  const PuglVulkanFrame* const frame =
+    (const PuglVulkanFrame*)puglGetContext(test->view);
+
+  assert(frame);
+  assert(frame->image);
+  assert(frame->imageView);
+  assert(frame->extent.width && frame->extent.height);
+  assert(frame->imageIndex < frame->numImages);
+  assert(frame->frameIndex == test->numExposes % N_FRAMES);
+  assert(frame->recreated || test->numExposes);
+  assert(frame->serial == test->numExposes + 1U);
+
+  // Clear the image to green
+  const VkCommandBuffer commandBuffer = test->commandBuffers[frame->frameIndex];
+
+  const VkClearColorValue       color = {{0.0f, 1.0f, 0.0f, 1.0f}};
+  const VkImageSubresourceRange range = {
+    VK_IMAGE_ASPECT_COLOR_BIT, 0U, 1U, 0U, 1U};
+
+  const VkCommandBufferBeginInfo beginInfo = {
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    NULL,
+    VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    NULL,
+  };
+
+  assert(!vkResetCommandBuffer(commandBuffer, 0U));
+  assert(!vkBeginCommandBuffer(commandBuffer, &beginInfo));
+  recordBarrier(commandBuffer,
+                frame->image,
+                VK_IMAGE_LAYOUT_UNDEFINED,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                0U,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT);
+  vkCmdClearColorImage(commandBuffer,
+                       frame->image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       &color,
+                       1U,
+                       &range);
+  recordBarrier(commandBuffer,
+                frame->image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                0U,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+  assert(!vkEndCommandBuffer(commandBuffer));
+
+  // Submit after the image is acquired, and signal that drawing is finished
+  const VkPipelineStageFlags waitStage  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  const VkSubmitInfo         submitInfo = {
+    VK_STRUCTURE_TYPE_SUBMIT_INFO,
+    NULL,
+    1U,
+    &frame->acquired,
+    &waitStage,
+    1U,
+    &commandBuffer,
+    1U,
+    &frame->rendered,
+  };
+
+  assert(!vkQueueSubmit(test->queue, 1U, &submitInfo, frame->fence));
+}
+
+static PuglStatus
+onEvent(PuglView* const view, const PuglEvent* const event)
+{
+  PuglTest* const test = (PuglTest*)puglGetHandle(view);
+
+  if (test->opts.verbose) {
+    printEvent(event, "Event: ", true);
+  }
+
+  if (event->type == PUGL_UPDATE &&
+      (test->numExposes < N_EXPOSES || (test->timing && !test->lastShown))) {
+    puglObscureView(view);
+  } else if (event->type == PUGL_EXPOSE && puglGetContext(view)) {
+    onExpose(test);
+    ++test->numExposes;
+  } else if (event->type == PUGL_PRESENT) {
+    assert(test->timing);
+    assert(event->present.kind == PUGL_PRESENT_COMPLETE);
+    assert(event->present.serial > test->lastShown);
+    assert(event->present.serial <= test->numExposes);
+    test->lastShown = event->present.serial;
+  }
+
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {0};
+  test.world    = puglNewWorld(PUGL_PROGRAM, 0);
+  test.view     = puglNewView(test.world);
+  test.opts     = puglParseTestOptions(&argc, &argv);
+
+  // Create Vulkan instance
+  assert(!createInstance(&test));
+
+  // Create window and its surface
+  puglSetWorldString(test.world, PUGL_CLASS_NAME, "PuglTest");
+  puglSetViewString(test.view, PUGL_WINDOW_TITLE, "Pugl Vulkan Swapchain Test");
+  puglSetHandle(test.view, &test);
+  puglSetBackend(test.view, puglVulkanBackend());
+  puglSetEventFunc(test.view, onEvent);
+  puglSetSizeHint(test.view, PUGL_DEFAULT_SIZE, 256, 256);
+  puglSetPositionHint(test.view, PUGL_DEFAULT_POSITION, 640, 640);
+  assert(!puglRealize(test.view));
+  assert(!puglCreateSurface(
+    vkGetInstanceProcAddr, test.view, test.instance, NULL, &test.surface));
+
+  // Create device and have Pugl manage the swapchain
+  assert(!createDevice(&test));
+
+  const PuglVulkanSwapchainOptions options = {
+    test.physicalDevice,
+    test.device,
+    test.queue,
+    test.surface,
+    NULL,
+    VK_FORMAT_B8G8R8A8_UNORM,
+    VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+    VK_PRESENT_MODE_FIFO_KHR,
+    N_FRAMES,
+    test.timing,
+  };
+
+  assert(!puglSetVulkanSwapchain(
+    test.view, vkGetInstanceProcAddr, test.instance, &options));
+
+  // Drive event loop until enough frames have been drawn (and shown)
+  assert(!puglGetContext(test.view));
+  assert(puglShow(test.view, PUGL_SHOW_RAISE) <= PUGL_FAILURE);
+  while (test.numExposes < N_EXPOSES || (test.timing && !test.lastShown)) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  // Check that a frame is only available during an expose
+  assert(!puglGetContext(test.view));
+
+  // Tear down, destroying the swapchain before the device and surface
+  assert(!puglSetVulkanSwapchain(
+    test.view, vkGetInstanceProcAddr, test.instance, NULL));
+  vkDestroyCommandPool(test.device, test.commandPool, NULL);
+  vkDestroyDevice(test.device, NULL);
+  vkDestroySurfaceKHR(test.instance, test.surface, NULL);
+  puglFreeView(test.view);
+  vkDestroyInstance(test.instance, NULL);
+  puglFreeWorld(test.world);
+
+  return 0;
+}
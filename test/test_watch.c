@@ -0,0 +1,114 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+// Tests that watched file descriptors are handled by the event loop
+
+#undef NDEBUG
+
+#include <puglutil/test_utils.h>
+
+#include <pugl/pugl.h>
+
+#include <assert.h>
+#include <stddef.h>
+#include <unistd.h>
+
+typedef struct {
+  PuglWorld*      world;
+  PuglTestOptions opts;
+  int             fds[2];
+  size_t          numReads;
+  size_t          numWrites;
+} PuglTest;
+
+static PuglStatus
+onReadable(PuglWorld* const     world,
+           const int            fd,
+           const PuglWatchFlags flags,
+           void* const          data)
+{
+  PuglTest* const test = (PuglTest*)data;
+
+  assert(world == test->world);
+  assert(fd == test->fds[0]);
+  assert(flags == PUGL_WATCH_READ);
+
+  char c = '\0';
+  assert(read(fd, &c, 1) == 1);
+  assert(c == 'p');
+  ++test->numReads;
+  return PUGL_SUCCESS;
+}
+
+static PuglStatus
+onWritable(PuglWorld* const     world,
+           const int            fd,
+           const PuglWatchFlags flags,
+           void* const          data)
+{
+  PuglTest* const test = (PuglTest*)data;
+
+  assert(world == test->world);
+  assert(fd == test->fds[1]);
+  assert(flags == PUGL_WATCH_WRITE);
+
+  // Write once, then stop watching from within the callback
+  assert(write(fd, "p", 1) == 1);
+  assert(!puglUnwatchFd(world, fd));
+  ++test->numWrites;
+  return PUGL_SUCCESS;
+}
+
+int
+main(int argc, char** argv)
+{
+  PuglTest test = {puglNewWorld(PUGL_PROGRAM, 0),
+                   puglParseTestOptions(&argc, &argv),
+                   {-1, -1},
+                   0U,
+                   0U};
+
+  assert(!pipe(test.fds));
+
+  // Check invalid cases
+  assert(puglWatchFd(test.world, -1, PUGL_WATCH_READ, onReadable, &test) ==
+         PUGL_BAD_PARAMETER);
+  assert(puglWatchFd(test.world, test.fds[0], 0U, onReadable, &test) ==
+         PUGL_BAD_PARAMETER);
+  assert(puglWatchFd(test.world, test.fds[0], PUGL_WATCH_READ, NULL, &test) ==
+         PUGL_BAD_PARAMETER);
+  assert(puglUnwatchFd(test.world, test.fds[0]) == PUGL_FAILURE);
+
+  // Watch both ends of the pipe
+  assert(!puglWatchFd(
+    test.world, test.fds[0], PUGL_WATCH_READ, onReadable, &test));
+  assert(!puglWatchFd(
+    test.world, test.fds[1], PUGL_WATCH_WRITE, onWritable, &test));
+
+  // Update until the written byte is read (which would block without it)
+  while (!test.numReads) {
+    assert(!puglUpdate(test.world, -1.0));
+  }
+
+  assert(test.numWrites == 1U);
+  assert(test.numReads == 1U);
+
+  // Check that nothing happens without any data
+  assert(!puglUpdate(test.world, 0.0));
+  assert(test.numReads == 1U);
+
+  // Check that the read end can be handled without waiting
+  assert(write(test.fds[1], "p", 1) == 1);
+  while (test.numReads < 2U) {
+    assert(!puglUpdate(test.world, 0.0));
+  }
+
+  // Tear down
+  assert(!puglUnwatchFd(test.world, test.fds[0]));
+  assert(puglUnwatchFd(test.world, test.fds[1]) == PUGL_FAILURE);
+  close(test.fds[0]);
+  close(test.fds[1]);
+  puglFreeWorld(test.world);
+
+  return 0;
+}